@@ -16,12 +16,125 @@
 #include <ctime>
 #include <iomanip>
 #include <random>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace pso
 {
     /** Integer type for indexing arrays, vectors and matrices. */
     typedef long int Index;
 
+    /** @brief Detects objectives that accept the index of the evaluated
+      * particle as second argument, e.g. to keep per-particle state. */
+    template<typename Objective, typename Vector, typename = void>
+    struct AcceptsParticleIndex : std::false_type
+    { };
+
+    template<typename Objective, typename Vector>
+    struct AcceptsParticleIndex<Objective, Vector,
+        decltype(void(std::declval<Objective &>()(std::declval<const Vector &>(), Index())))>
+        : std::true_type
+    { };
+
+    /** @brief Uniform random number generator, which runs four independent
+      * xoshiro256+ streams side by side.
+      *
+      * The lanes are updated in plain loops over four elements, which
+      * compilers turn into SIMD code, so filling whole matrices is much
+      * cheaper than drawing every element through a std::function. */
+    class Xoshiro256PlusX4
+    {
+    public:
+        static constexpr int Lanes = 4;
+
+        explicit Xoshiro256PlusX4(const std::uint64_t seed = 0)
+        {
+            this->seed(seed);
+        }
+
+        /** Seed all lanes from a single value using splitmix64.
+          * @param seed seed of the generator */
+        void seed(std::uint64_t seed)
+        {
+            for(int lane = 0; lane < Lanes; ++lane)
+            {
+                s0_[lane] = splitmix64(seed);
+                s1_[lane] = splitmix64(seed);
+                s2_[lane] = splitmix64(seed);
+                s3_[lane] = splitmix64(seed);
+            }
+        }
+
+        /** Fill the given buffer with uniform values in [0, 1).
+          * @param out buffer to be filled
+          * @param cnt number of values */
+        template<typename Scalar>
+        void fill(Scalar *out, const Index cnt)
+        {
+            std::uint64_t block[Lanes];
+            Index i = 0;
+            for(; i + Lanes <= cnt; i += Lanes)
+            {
+                next(block);
+                for(int lane = 0; lane < Lanes; ++lane)
+                    out[i + lane] = toUniform<Scalar>(block[lane]);
+            }
+            if(i < cnt)
+            {
+                next(block);
+                for(int lane = 0; i < cnt; ++i, ++lane)
+                    out[i] = toUniform<Scalar>(block[lane]);
+            }
+        }
+
+        template<typename Derived>
+        void fill(Eigen::PlainObjectBase<Derived> &out)
+        {
+            fill(out.data(), out.size());
+        }
+
+    private:
+        std::uint64_t s0_[Lanes];
+        std::uint64_t s1_[Lanes];
+        std::uint64_t s2_[Lanes];
+        std::uint64_t s3_[Lanes];
+
+        static std::uint64_t splitmix64(std::uint64_t &state)
+        {
+            std::uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            return z ^ (z >> 31);
+        }
+
+        template<typename Scalar>
+        static Scalar toUniform(const std::uint64_t x)
+        {
+            // upper 53 bits as a double in [0, 1)
+            return static_cast<Scalar>(static_cast<double>(x >> 11) * 0x1.0p-53);
+        }
+
+        void next(std::uint64_t *result)
+        {
+            for(int lane = 0; lane < Lanes; ++lane)
+            {
+                result[lane] = s0_[lane] + s3_[lane];
+                const std::uint64_t t = s1_[lane] << 17;
+                s2_[lane] ^= s0_[lane];
+                s3_[lane] ^= s1_[lane];
+                s1_[lane] ^= s2_[lane];
+                s0_[lane] ^= s3_[lane];
+                s2_[lane] ^= t;
+                s3_[lane] = (s3_[lane] << 45) | (s3_[lane] >> 19);
+            }
+        }
+    };
+
     /** @brief Dummy callback functor, which always and only returns true. */
     template<typename Scalar>
     class NoCallback
@@ -268,7 +381,9 @@ namespace pso
 
         Index verbosity_;
 
-        std::function<Scalar()> dice_;
+        Xoshiro256PlusX4 rng_;
+        Matrix randP_;
+        Matrix randG_;
 
         template<typename Derived>
         std::string vector2str(const Eigen::MatrixBase<Derived> &vec) const
@@ -292,53 +407,56 @@ namespace pso
 
         void randomizeParticles(const Matrix &bounds, Matrix &particles)
         {
-            for(Index i = 0; i < particles.cols(); ++i)
-            {
-                for(Index j = 0; j < particles.rows(); ++j)
-                {
-                    Scalar minval = bounds(0, j);
-                    Scalar maxval = bounds(1, j);
-                    Scalar diff = maxval - minval;
-                    particles(j, i) = minval + (dice_() * diff);
-                }
-            }
+            const Vector minval = bounds.row(0).transpose();
+            const Vector diff = (bounds.row(1) - bounds.row(0)).transpose();
+
+            rng_.fill(particles);
+            particles = (particles.array().colwise() * diff.array()).colwise()
+                + minval.array();
         }
 
         void randomizeVelocities(const Matrix &bounds, Matrix &velocities)
         {
-            for(Index i = 0; i < velocities.cols(); ++i)
-            {
-                for(Index j = 0; j < velocities.rows(); ++j)
-                {
-                    Scalar minval = bounds(0, j);
-                    Scalar maxval = bounds(1, j);
-                    Scalar diff = maxval - minval;
-                    Scalar vel = -diff + (dice_() * 2 * diff);
-                    velocities(j, i) = std::min(maxVel_, std::max(-maxVel_, vel));
-                }
-            }
+            const Vector diff = (bounds.row(1) - bounds.row(0)).transpose();
+
+            rng_.fill(velocities);
+            velocities = ((velocities.array() * 2 - 1).colwise() * diff.array())
+                .max(-maxVel_).min(maxVel_);
         }
 
         void evaluateObjective(const Matrix &particles,
             Vector &fvals)
         {
-            #pragma omp parallel for num_threads(threads_)
+#ifdef _OPENMP
+            // 0 or negative threads_ means one thread per core
+            const int threads = threads_ > 0 ? static_cast<int>(threads_) : omp_get_max_threads();
+            #pragma omp parallel for num_threads(threads)
+#endif
             for(Index i = 0; i < particles.cols(); ++i)
-                fvals(i) = objective_(particles.col(i));
+                fvals(i) = evaluateParticle(particles.col(i), i,
+                    AcceptsParticleIndex<Objective, Vector>());
+        }
+
+        template<typename Derived>
+        Scalar evaluateParticle(const Eigen::MatrixBase<Derived> &particle,
+            const Index, std::false_type)
+        {
+            return objective_(particle);
+        }
+
+        template<typename Derived>
+        Scalar evaluateParticle(const Eigen::MatrixBase<Derived> &particle,
+            const Index index, std::true_type)
+        {
+            return objective_(particle, index);
         }
 
         void maintainBounds(const Matrix &bounds, Matrix &particles) const
         {
-            for(Index i = 0; i < particles.cols(); ++i)
-            {
-                for(Index j = 0; j < particles.rows(); ++j)
-                {
-                    Scalar minval = bounds(0, j);
-                    Scalar maxval = bounds(1, j);
-                    Scalar val = particles(j, i);
-                    particles(j, i) = std::min(maxval, std::max(minval, val));
-                }
-            }
+            const Index cols = particles.cols();
+            particles = particles.array()
+                .max(bounds.row(0).transpose().replicate(1, cols).array())
+                .min(bounds.row(1).transpose().replicate(1, cols).array());
         }
 
         void calculateVelocities(const Matrix &particles,
@@ -355,20 +473,18 @@ namespace pso
 
             Scalar weight = weightStrategy_(iteration, maxIt_);
 
-            for(Index i = 0; i < velocities.cols(); ++i)
-            {
-                for(Index j = 0; j < velocities.rows(); ++j)
-                {
-                    Scalar velp = dice_() * (bestParticles(j, i) - particles(j, i));
-                    Scalar velg = dice_() * (bestParticles(j, gbest) - particles(j, i));
-                    Scalar vel = weight * velocities(j, i) + phip_ * velp + phig_ * velg;
+            randP_.resize(velocities.rows(), velocities.cols());
+            randG_.resize(velocities.rows(), velocities.cols());
+            rng_.fill(randP_);
+            rng_.fill(randG_);
 
-                    if(maxVel_ > 0)
-                        vel = std::min(maxVel_, std::max(-maxVel_, vel));
+            auto velp = randP_.array() * (bestParticles - particles).array();
+            auto velg = randG_.array() * ((-particles).colwise()
+                + bestParticles.col(gbest)).array();
+            velocities = weight * velocities.array() + phip_ * velp + phig_ * velg;
 
-                    velocities(j, i) = vel;
-                }
-            }
+            if(maxVel_ > 0)
+                velocities = velocities.array().max(-maxVel_).min(maxVel_);
         }
 
         Result _minimize(const Matrix &bounds,
@@ -460,6 +576,10 @@ namespace pso
                 }
 
                 ++iterations;
+
+                // the callback asked to stop
+                if(!callbackResult)
+                    break;
             }
 
             Result result;
@@ -478,11 +598,17 @@ namespace pso
             maxIt_(0), xeps_(static_cast<Scalar>(1e-6)),
             feps_(static_cast<Scalar>(1e-6)), phip_(static_cast<Scalar>(2.0)),
             phig_(static_cast<Scalar>(2.0)), maxVel_(static_cast<Scalar>(0.0)),
-            verbosity_(0), dice_()
+            verbosity_(0), rng_(static_cast<std::uint64_t>(std::time(0))),
+            randP_(), randG_()
+        {
+        }
+
+        /** Set the seed of the random number generator, which is otherwise
+          * seeded with the current time.
+          * @param seed seed of the generator */
+        void setSeed(const std::uint64_t seed)
         {
-            std::default_random_engine gen(std::time(0));
-            std::uniform_real_distribution<Scalar> distrib(0.0, 1.0);
-            dice_ = std::bind(distrib, gen);
+            rng_.seed(seed);
         }
 
         /** Set the amount of threads, which are used for evaluating the
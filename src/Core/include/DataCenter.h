@@ -1,17 +1,30 @@
 #pragma once
 
 #include <vector>
+#include <map>
 #include <unordered_map>
 #include <mutex>
+#include <atomic>
+#include <future>
+#include <string>
 #include "data/PhysicalMachine.h"
 #include "data/VirtualMachine.h"
+#include "data/FleetStatistics.h"
 #include "events/VMRequestEvent.h"
 #include "events/VMUtilUpdateEvent.h"
 #include "events/VMDepartureEvent.h"
 #include "events/MigrationCompleteEvent.h"
+#include "events/PlacementFlushEvent.h"
+#include "events/PlacementReadyEvent.h"
+#include "events/ConsolidationEvent.h"
 #include "strategies/StrategyFactory.h"
+#include "strategies/LocalSearchStrategy.h"
+#include "MigrationCandidateSet.h"
+#include "PlacementScheduler.h"
+#include "PlacementRepair.h"
+#include "PlacementCache.h"
+#include "PlacementPartitioner.h"
 #include "logging/LogManager.h"
-#include <random>
 
 class SimulationEngine;
 
@@ -26,6 +39,13 @@ public:
     void handle(const VMUtilUpdateEvent &event, SimulationEngine &engine);
     void handle(const VMDepartureEvent &event, SimulationEngine &engine);
     void handle(const MigrationCompleteEvent &event, SimulationEngine &engine);
+    void handle(const PlacementFlushEvent &event, SimulationEngine &engine);
+    void handle(const PlacementReadyEvent &event, SimulationEngine &engine);
+    void handle(const ConsolidationEvent &event, SimulationEngine &engine);
+
+    // Events of one timestamp are handled between these, see SimulationEngine::runLoop
+    void beginBatch();
+    void endBatch(SimulationEngine &engine);
 
     void addPhysicalMachine(const PhysicalMachine &pm);
 
@@ -33,13 +53,65 @@ public:
     IPlacementStrategy *getPlacementStrategy() const;
 
     // For bundling
-    size_t getBundleSize() const { return m_strategy->getBundleSize(); }
+    size_t getBundleSize() const { return m_scheduler.getBundleSize(m_strategy->getBundleSize()); }
+    void setMaxBundleWait(double seconds);
+    double getMaxBundleWait() const;
+    void setBundleSizingMode(BundleSizingMode mode);
+    BundleSizingMode getBundleSizingMode() const;
+    // Limits and solve time target of the adaptive bundle size
+    void setAdaptiveBundleLimits(size_t minSize, size_t maxSize);
+    size_t getAdaptiveBundleMinSize() const;
+    size_t getAdaptiveBundleMaxSize() const;
+    void setTargetSolveTime(double seconds);
+    double getTargetSolveTime() const;
+    double getAveragePlacementDelay() const;
+    double getMaxPlacementDelay() const;
+    double getArrivalRate() const;
+    double getLastSolveTime() const;
+
+    // Asynchronous placement: the strategy runs on a worker against a snapshot and its
+    // decisions are committed the decision latency later in simulated time
+    void setAsyncPlacement(bool enabled) { m_asyncPlacement = enabled; }
+    bool isAsyncPlacement() const { return m_asyncPlacement; }
+    void setDecisionLatency(double seconds) { m_decisionLatency = seconds; }
+    double getDecisionLatency() const { return m_decisionLatency; }
+
+    // Placement latency SLO: every strategy run gets this wall-clock budget, 0 leaves it unbounded
+    void setPlacementDeadline(double seconds) { m_placementDeadline = seconds; }
+    double getPlacementDeadline() const { return m_placementDeadline; }
+    size_t getPlacementDeadlineMisses() const { return m_placementDeadlineMisses; }
+    size_t getIncompletePlacementCount() const { return m_incompletePlacements; }
+
+    // Reuses the decisions of an earlier identical bundle on an unchanged part of the fleet
+    void setPlacementCache(bool enabled) { m_placementCacheEnabled = enabled; }
+    bool isPlacementCache() const { return m_placementCacheEnabled; }
+    PlacementCache::Statistics getPlacementCacheStatistics() const { return m_placementCache.getStatistics(); }
+
+    // Periodic consolidation: every interval of simulated time a local search improves the standing
+    // placement within the budget of wall-clock time and migrates what it moved. 0 turns it off
+    void setConsolidationInterval(double seconds) { m_consolidationInterval = seconds; }
+    double getConsolidationInterval() const { return m_consolidationInterval; }
+    void setConsolidationBudget(double seconds) { m_consolidationBudget = seconds; }
+    double getConsolidationBudget() const { return m_consolidationBudget; }
+    size_t getConsolidationMigrationCount() const { return m_consolidationMigrations; }
+
+    // Clustered placement: the fleet is split into clusters of consecutive PM ids, each placing its
+    // share of the bundle with its own instance of the named strategy in parallel. 0 PMs turns it off
+    void setPlacementClustering(size_t clusterSize, const std::string &strategyName);
+    size_t getPlacementClusterSize() const { return m_partitioner.getClusterSize(); }
+    std::string getPlacementClusterStrategy() const { return m_partitioner.getStrategyName(); }
+    PlacementPartitioner::Statistics getPlacementClusteringStatistics() const { return m_partitioner.getStatistics(); }
+
+    // Which VMs of an overcommitted PM are handed to the strategy for migration
+    void setMigrationSelectionPolicy(MigrationSelectionPolicy policy);
+    MigrationSelectionPolicy getMigrationSelectionPolicy() const;
 
     // Thread-safe updates
     bool updateVM(int vmId, double utilization);
     bool removeVM(int vmId);
 
     const std::vector<PhysicalMachine> &getPhysicalMachines() const { return m_physicalMachines; }
+    const FleetStatistics &getFleetStatistics() const { return m_fleetStatistics; }
     std::vector<MachineUsageInfo> getMachineUsageInfo() const;
     Resources getResourceUtilizations() const;
     size_t getTurnedOnMachineCount() const;
@@ -52,22 +124,90 @@ public:
 
 private:
     void runPlacement(SimulationEngine &engine);
+    void launchPlacement(SimulationEngine &engine);
+    void commitPlacement(SimulationEngine &engine);
+    Results solvePlacement(IPlacementStrategy *strategy, const std::vector<VirtualMachine *> &newRequests, const std::vector<VirtualMachine *> &toMigrate, const std::vector<PhysicalMachine> &machines, const PlacementBudget &budget, bool solveInPlace, std::string &solvedBy);
+    std::vector<int> validateDecisions(Results &decisions);
+    // solvedBy names what took the decisions in the logs, returns the number of migrations scheduled
+    size_t commitDecisions(Results &decisions, const std::string &solvedBy, SimulationEngine &engine);
+    void schedulePendingPlacement(SimulationEngine &engine);
+    PlacementBudget placementBudget() const;
+    void recordPlacementQuality(const PlacementQuality &quality);
+    void scheduleConsolidation(SimulationEngine &engine, double now);
+    void runConsolidation(SimulationEngine &engine);
+    void applyBatchedUpdates(SimulationEngine &engine);
     void scheduleMigration(SimulationEngine &engine, int vmID, int new_pmID, unsigned int numberOfMigrations);
     bool detectOvercommitment(int pmId, SimulationEngine &engine);
     double computeMigrationTime(VirtualMachine *vm, unsigned int numberOfMigrations) const;
 
     void placeVMonPM(VirtualMachine *vm, int pmId, SimulationEngine &engine);
 
+    // Every change to a machine goes through here to keep the fleet statistics in sync
+    template <typename Mutation>
+    void mutateMachine(PhysicalMachine &pm, Mutation &&mutation)
+    {
+        m_fleetStatistics.remove(pm);
+        mutation(pm);
+        m_fleetStatistics.add(pm);
+    }
+
     mutable std::mutex m_strategyMutex;
     IPlacementStrategy *m_strategy;
 
     // Bundling
     mutable std::mutex m_bundleMutex;
     std::vector<VirtualMachine *> m_pendingNewRequests;
-    std::vector<VirtualMachine *> m_pendingMigrations;
+    PlacementScheduler m_scheduler;
+    MigrationCandidateSet m_migrationCandidates;
+    PlacementRepair m_repair;
+
+    // Batching of the events with the same timestamp
+    bool m_inBatch{false};
+    bool m_batchPlacementRequested{false};
+    std::map<int, double> m_batchedUpdates; // vmId -> latest utilization of the batch
+    bool m_batchCommitRequested{false};
+    bool m_batchConsolidationRequested{false};
+
+    // Asynchronous placement, touched by the engine thread only except the strategy pointer
+    struct InFlightPlacement
+    {
+        bool active{false};
+        std::future<Results> decisions;
+        IPlacementStrategy *strategy{nullptr};         // guarded by m_strategyMutex, deleted after the commit if replaced meanwhile
+        std::vector<VirtualMachine *> newRequests;     // owned until committed or re-queued
+        std::vector<VirtualMachine *> vmClones;        // copies of the hosted VMs the snapshot points to, owned
+        std::vector<VirtualMachine *> migrationClones; // copies of the migration candidates, among vmClones
+        std::vector<PhysicalMachine> machines;         // snapshot the strategy runs against
+        double solveSeconds{0.0};                      // written by the worker before the future is ready
+        std::string solvedBy;                          // likewise
+    };
+    std::atomic<bool> m_asyncPlacement{false};
+    std::atomic<double> m_decisionLatency{1.0};
+    InFlightPlacement m_inFlight;
+
+    // Placement deadline
+    std::atomic<double> m_placementDeadline{0.0};
+    std::atomic<bool> m_placementCancel{false}; // stops a running strategy at shutdown
+    std::atomic<size_t> m_placementDeadlineMisses{0};
+    std::atomic<size_t> m_incompletePlacements{0}; // runs the budget cut short
+
+    // Decision cache, shared by the engine thread and the placement worker
+    std::atomic<bool> m_placementCacheEnabled{false};
+    PlacementCache m_placementCache;
+
+    // Clustered placement, solves on the thread that places the bundle
+    PlacementPartitioner m_partitioner;
+
+    // Periodic consolidation, the pass runs on the engine thread
+    std::atomic<double> m_consolidationInterval{0.0};
+    std::atomic<double> m_consolidationBudget{1.0};
+    std::atomic<size_t> m_consolidationMigrations{0};
+    bool m_consolidationScheduled{false}; // a ConsolidationEvent is queued
+    LocalSearchStrategy m_consolidator;
 
     // Physical machines
     std::vector<PhysicalMachine> m_physicalMachines;
+    FleetStatistics m_fleetStatistics;
 
     // VM index
     std::unordered_map<int, std::pair<int, VirtualMachine *>> m_vmIndex;
@@ -3,6 +3,8 @@
 #include <cstddef>
 #include <string>
 #include "strategies/IPlacementStrategy.h"
+#include "MigrationCandidateSet.h"
+#include "PlacementScheduler.h"
 
 class ISimulationConfiguration
 {
@@ -11,7 +13,36 @@ public:
 
     virtual void setPlacementStrategy(IPlacementStrategy *strategy) = 0;
     virtual void setOutputFile(const std::string &filename) = 0;
+    virtual void setMigrationSelectionPolicy(MigrationSelectionPolicy policy) = 0;
+    virtual void setMaxBundleWait(double seconds) = 0;
+    virtual void setBundleSizingMode(BundleSizingMode mode) = 0;
+    virtual void setAdaptiveBundleLimits(size_t minSize, size_t maxSize) = 0;
+    virtual void setTargetSolveTime(double seconds) = 0;
+    virtual void setEventBatching(bool enabled) = 0;
+    virtual void setAsyncPlacement(bool enabled) = 0;
+    virtual void setDecisionLatency(double seconds) = 0;
+    virtual void setPlacementDeadline(double seconds) = 0;
+    virtual void setPlacementCache(bool enabled) = 0;
+    virtual void setConsolidationInterval(double seconds) = 0;
+    virtual void setConsolidationBudget(double seconds) = 0;
+    // An empty strategy name runs copies of the placement strategy on the clusters
+    virtual void setPlacementClustering(size_t clusterSize, const std::string &strategyName) = 0;
 
     virtual size_t getBundleSize() const = 0;
     virtual IPlacementStrategy *getPlacementStrategy() const = 0;
+    virtual MigrationSelectionPolicy getMigrationSelectionPolicy() const = 0;
+    virtual double getMaxBundleWait() const = 0;
+    virtual BundleSizingMode getBundleSizingMode() const = 0;
+    virtual size_t getAdaptiveBundleMinSize() const = 0;
+    virtual size_t getAdaptiveBundleMaxSize() const = 0;
+    virtual double getTargetSolveTime() const = 0;
+    virtual bool isEventBatching() const = 0;
+    virtual bool isAsyncPlacement() const = 0;
+    virtual double getDecisionLatency() const = 0;
+    virtual double getPlacementDeadline() const = 0;
+    virtual bool isPlacementCache() const = 0;
+    virtual double getConsolidationInterval() const = 0;
+    virtual double getConsolidationBudget() const = 0;
+    virtual size_t getPlacementClusterSize() const = 0;
+    virtual std::string getPlacementClusterStrategy() const = 0;
 };
\ No newline at end of file
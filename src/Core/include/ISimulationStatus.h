@@ -29,4 +29,14 @@ public:
     virtual double getAveragePowerConsumption() const = 0;
     virtual double getTotalPowerConsumption() const = 0;
     virtual size_t getNumberOfSLAViolations() const = 0;
+    virtual double getAveragePlacementDelay() const = 0;
+    virtual double getMaxPlacementDelay() const = 0;
+    virtual double getArrivalRate() const = 0;
+    virtual double getLastSolveTime() const = 0;
+    virtual size_t getPlacementCacheLookups() const = 0;
+    virtual size_t getPlacementCacheHits() const = 0;
+    virtual size_t getConsolidationMigrationCount() const = 0;
+    virtual size_t getClusteredPlacementCount() const = 0;
+    virtual size_t getActiveClusterCount() const = 0;
+    virtual size_t getClusterCount() const = 0;
 };
\ No newline at end of file
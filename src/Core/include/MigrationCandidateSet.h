@@ -0,0 +1,55 @@
+#pragma once
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "data/PhysicalMachine.h"
+#include "data/VirtualMachine.h"
+
+enum class MigrationSelectionPolicy
+{
+    AllVMs,                // Every non-migrating VM on the overcommitted PM
+    MinimumMigrationTime,  // Fastest migrations first until the PM is relieved
+    MinimumExcessKnapsack, // Least migrated load that still covers the excess
+};
+
+struct MigrationSelectionPolicyInfo
+{
+    MigrationSelectionPolicy policy;
+    std::string displayName;
+};
+
+/**
+ * Collects the VMs to hand to the placement strategy as migration requests.
+ * Each VM is queued at most once until the next placement, and only the subset
+ * needed to bring an overcommitted PM back under the threshold is queued.
+ */
+class MigrationCandidateSet
+{
+public:
+    static std::vector<MigrationSelectionPolicyInfo> availablePolicies();
+
+    void setPolicy(MigrationSelectionPolicy policy) { m_policy = policy; }
+    MigrationSelectionPolicy getPolicy() const { return m_policy; }
+
+    // Queue the VMs of an overcommitted PM, returns the number of newly queued VMs
+    size_t addFromMachine(const PhysicalMachine &pm, double threshold);
+
+    // Drop a VM, e.g. when it departs before the next placement
+    void remove(int vmId);
+    bool contains(int vmId) const { return m_queuedIds.count(vmId) > 0; }
+
+    const std::vector<VirtualMachine *> &getCandidates() const { return m_candidates; }
+    size_t size() const { return m_candidates.size(); }
+    bool empty() const { return m_candidates.empty(); }
+    void clear();
+
+private:
+    std::vector<VirtualMachine *> selectMinimumMigrationTime(std::vector<VirtualMachine *> &vms, const Resources &excess) const;
+    std::vector<VirtualMachine *> selectMinimumExcessKnapsack(std::vector<VirtualMachine *> &vms, const Resources &excess, const Resources &total) const;
+
+    MigrationSelectionPolicy m_policy{MigrationSelectionPolicy::MinimumMigrationTime};
+
+    std::vector<VirtualMachine *> m_candidates;
+    std::unordered_set<int> m_queuedIds;
+};
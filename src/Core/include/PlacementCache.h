@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "data/PhysicalMachine.h"
+#include "strategies/IPlacementStrategy.h"
+
+/**
+ * Memoizes the decisions of a placement strategy across bundles.
+ * A bundle is keyed by its requests in a canonical order: sorted quantized resource
+ * vectors, with the source PM of the migrations, followed by a coarse signature of the
+ * fleet: for each class of identical requests, how many turned on PMs could host one,
+ * counted up to the size of the class. The decisions are stored per canonical request
+ * together with the quantized free resources of the PMs they use. A later bundle with the
+ * same key reuses them on PMs that have the same residuals, the stored ones when they
+ * still do, as long as the decisions fit the current machines; identical requests and PMs
+ * with identical residuals are interchangeable. The fleet signature keeps a decision that
+ * powered on a PM from being replayed once departures left room on the turned on ones.
+ * Resources are quantized in steps of a fraction of the largest PM of the fleet.
+ */
+class PlacementCache
+{
+public:
+    struct Statistics
+    {
+        size_t lookups{0};
+        size_t hits{0};
+        size_t rejected{0}; // same bundle, but no PMs with the stored residuals or the decisions no longer fit
+
+        double hitRate() const { return lookups > 0 ? double(hits) / lookups : 0.0; }
+    };
+
+    explicit PlacementCache(size_t capacity = 1024, double quantum = 0.01);
+
+    // Drops the entries, the statistics are kept
+    void clear();
+
+    void setCapacity(size_t capacity);
+    size_t getCapacity() const;
+    // Clears the entries, they were quantized with the previous step
+    void setQuantum(double quantum);
+    double getQuantum() const;
+
+    // Fills the decisions from an earlier identical bundle, false on a miss
+    bool lookup(const std::vector<VirtualMachine *> &newRequests, const std::vector<VirtualMachine *> &toMigrate, const std::vector<PhysicalMachine> &machines, Results &decisions);
+    // Remembers the decisions taken for the bundle on these machines
+    void store(const std::vector<VirtualMachine *> &newRequests, const std::vector<VirtualMachine *> &toMigrate, const std::vector<PhysicalMachine> &machines, const Results &decisions);
+
+    Statistics getStatistics() const;
+    size_t size() const;
+
+private:
+    // Canonical form of a bundle
+    struct Signature
+    {
+        std::vector<long> key;     // quantized requests in canonical order, then the fleet signature
+        std::vector<size_t> order; // canonical rank -> position, newcomers first and then migrations
+        uint64_t hash{0};
+    };
+
+    struct Entry
+    {
+        Signature signature;
+        std::vector<int> targets;                                 // PM per canonical rank, -1 unplaced or not migrated
+        std::vector<std::pair<int, std::vector<long>>> residuals; // PM id -> quantized free resources when stored
+    };
+
+    Signature signature(const std::vector<VirtualMachine *> &newRequests, const std::vector<VirtualMachine *> &toMigrate, const std::vector<PhysicalMachine> &machines) const;
+    std::vector<long> fleetSignature(const std::vector<long> &requests, const std::vector<size_t> &order, const std::vector<PhysicalMachine> &machines) const;
+    std::vector<long> residual(const PhysicalMachine &pm) const;
+    void setSteps(const std::vector<PhysicalMachine> &machines);
+
+    size_t m_capacity;
+    double m_quantum;
+    Resources m_steps; // quantization step per dimension, from the largest PM
+
+    std::list<Entry> m_entries; // most recently used first
+    std::unordered_map<uint64_t, std::list<Entry>::iterator> m_index;
+    Statistics m_statistics;
+    mutable std::mutex m_mutex;
+};
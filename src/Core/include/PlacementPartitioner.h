@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "data/PhysicalMachine.h"
+#include "strategies/IPlacementStrategy.h"
+
+/**
+ * Places a bundle on a large fleet by splitting it into clusters of consecutive PM ids.
+ * A dispatcher routes each new request to a cluster from a summary of the free capacity
+ * of its PMs, spreading the bundle over the clusters with the most room; a migration
+ * stays in the cluster of its source PM. Every cluster with requests then runs its own
+ * instance of the strategy on its PMs only, the clusters in parallel, and the decisions are
+ * merged. The instances are copies of the placement strategy with its settings, or, when a
+ * factory name is set, fresh instances of that strategy with its default settings. A request its cluster cannot place is left
+ * unplaced for the repair of DataCenter, which sees the whole fleet; migration candidates
+ * a cluster strategy keeps in place are not emitted, as with the unpartitioned strategy.
+ */
+class PlacementPartitioner
+{
+public:
+    struct Statistics
+    {
+        size_t runs{0};
+        size_t clusters{0};       // clusters of the last run
+        size_t activeClusters{0}; // clusters the last run gave requests to
+        size_t unplaced{0};       // decisions left to the repair, over all runs
+    };
+
+    PlacementPartitioner();
+    ~PlacementPartitioner();
+
+    // PMs per cluster, 0 turns the partitioning off
+    void setClusterSize(size_t machines);
+    size_t getClusterSize() const;
+    // Factory name of the per-cluster strategies, empty for copies of the placement strategy. Throws
+    // for strategies that need the whole data center
+    void setStrategyName(const std::string &name);
+    std::string getStrategyName() const;
+    // Worker threads, 0 for one per hardware thread
+    void setThreadCount(unsigned threads);
+    unsigned getThreadCount() const;
+
+    // A fleet that fits one cluster is not worth partitioning
+    bool appliesTo(const std::vector<PhysicalMachine> &machines) const;
+
+    // The copies of the placement strategy are taken again on the next solve, its settings changed
+    void invalidateStrategies();
+
+    // placementStrategy is copied per cluster when no factory name is set
+    Results solve(const std::vector<VirtualMachine *> &newRequests, const std::vector<VirtualMachine *> &toMigrate, const std::vector<PhysicalMachine> &machines, const PlacementBudget &budget,
+                  const IPlacementStrategy *placementStrategy);
+
+    Statistics getStatistics() const;
+
+private:
+    // Free capacity of a cluster, kept while the dispatcher routes requests to it
+    struct Cluster
+    {
+        std::vector<size_t> positions; // PMs of the cluster in the fleet
+        Resources capacity;
+        Resources free;
+        Resources largestFree; // per dimension over the PMs, so fitting it is necessary but not sufficient
+        std::vector<VirtualMachine *> newRequests;
+        std::vector<VirtualMachine *> toMigrate;
+    };
+
+    std::vector<Cluster> partition(const std::vector<PhysicalMachine> &machines, size_t clusterSize) const;
+    int route(const Resources &need, std::vector<Cluster> &clusters) const;
+    void prepareStrategies(size_t count, const std::string &name, const IPlacementStrategy *placementStrategy, bool stale);
+
+    size_t m_clusterSize{0};
+    std::string m_strategyName;
+    unsigned m_threads{0};
+    bool m_strategiesStale{false};
+    Statistics m_statistics;
+    mutable std::mutex m_mutex; // the settings and the statistics
+
+    // One strategy per cluster, reused across runs while the name and the placement strategy hold
+    std::vector<IPlacementStrategy *> m_strategies;
+    std::string m_strategiesName;
+    const IPlacementStrategy *m_strategiesSource{nullptr}; // placement strategy the copies were taken of
+    std::mutex m_solveMutex;
+};
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <map>
+#include <random>
+#include <vector>
+#include "data/PhysicalMachine.h"
+#include "strategies/IPlacementStrategy.h"
+
+/**
+ * Makes the decisions of a placement strategy feasible before they are committed.
+ * The decisions are replayed against the free capacity of the fleet; a decision
+ * whose PM cannot host the VM is moved to the best fitting turned on PM, or to a
+ * turned off PM when no turned on PM fits. Ties between equally good PMs are broken
+ * with a seeded generator so that runs are reproducible.
+ */
+class PlacementRepair
+{
+public:
+    explicit PlacementRepair(unsigned int seed = 42) : m_rng(seed) {}
+
+    void setSeed(unsigned int seed) { m_rng.seed(seed); }
+
+    // Returns the number of decisions that were moved or dropped.
+    // New requests that fit nowhere keep pmId = -1, migrations that fit nowhere are dropped with pmId = -1.
+    // A migration the strategy left at pmId = -1 means the VM stays and is not repaired.
+    size_t repair(Results &decisions, const std::vector<PhysicalMachine> &machines);
+
+private:
+    // Free capacity of one PM, kept in the lookup keyed by its free CPU
+    struct Slot
+    {
+        Resources free;
+        bool turnedOn;
+        std::multimap<double, int>::iterator position;
+    };
+
+    void reset(const std::vector<PhysicalMachine> &machines);
+    bool fits(int pmId, const Resources &usage) const;
+    void commit(int pmId, const Resources &usage);
+    int findBestFit(const Resources &usage, int excludedPmId);
+    int findBestFit(const std::multimap<double, int> &pool, const Resources &usage, int excludedPmId);
+
+    std::mt19937 m_rng;
+
+    std::vector<Slot> m_slots;
+    std::multimap<double, int> m_turnedOnPool;
+    std::multimap<double, int> m_turnedOffPool;
+};
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+enum class BundleSizingMode
+{
+    Strategy, // Use the bundle size of the placement strategy
+    Adaptive, // Grow or shrink from the arrival rate and the measured solve time
+};
+
+/**
+ * Decides when the pending requests are handed to the placement strategy.
+ * A bundle is placed when it reaches the bundle size or when its oldest request
+ * has waited the maximum wait in simulated time, whichever comes first.
+ */
+class PlacementScheduler
+{
+public:
+    // Maximum simulated wait of a request before its bundle is flushed, <= 0 disables it
+    void setMaxWait(double seconds) { m_maxWait = seconds; }
+    double getMaxWait() const { return m_maxWait; }
+
+    void setSizingMode(BundleSizingMode mode);
+    BundleSizingMode getSizingMode() const { return m_sizingMode; }
+
+    void setBundleSizeLimits(size_t minSize, size_t maxSize);
+    size_t getMinBundleSize() const { return m_minBundleSize; }
+    size_t getMaxBundleSize() const { return m_maxBundleSize; }
+    // Wall-clock solve time the adaptive policy aims for per bundle
+    void setTargetSolveTime(double seconds) { m_targetSolveTime = seconds; }
+    double getTargetSolveTime() const { return m_targetSolveTime; }
+
+    size_t getBundleSize(size_t strategyBundleSize) const;
+
+    // Called for each arriving request to track the arrival rate
+    void onRequestArrival(double time);
+    // Called after every strategy run with its wall-clock solve time
+    void onPlacement(size_t bundleSize, double solveSeconds);
+    void onVMPlaced(double delay);
+
+    // Flush events carry the generation they were scheduled in, placements invalidate them
+    uint64_t getGeneration() const { return m_generation; }
+    bool needsFlush(size_t pendingBefore) const { return m_maxWait > 0 && pendingBefore == 0; }
+
+    double getArrivalRate() const { return m_meanInterArrival > 0 ? 1.0 / m_meanInterArrival : 0.0; }
+    double getLastSolveTime() const { return m_lastSolveTime; }
+    double getAveragePlacementDelay() const { return m_placedCount > 0 ? m_totalDelay / m_placedCount : 0.0; }
+    double getMaxPlacementDelay() const { return m_maxDelay; }
+
+private:
+    static constexpr double EWMA_ALPHA = 0.1;
+
+    double m_maxWait{300.0}; // one trace sampling period
+    BundleSizingMode m_sizingMode{BundleSizingMode::Strategy};
+    size_t m_minBundleSize{1};
+    size_t m_maxBundleSize{200};
+    double m_targetSolveTime{1.0};
+    double m_adaptiveBundleSize{10.0};
+
+    uint64_t m_generation{0};
+
+    double m_lastArrival{-1.0};
+    double m_meanInterArrival{0.0};
+    double m_lastSolveTime{0.0};
+
+    size_t m_placedCount{0};
+    double m_totalDelay{0.0};
+    double m_maxDelay{0.0};
+};
@@ -35,12 +35,50 @@ public:
     double getAveragePowerConsumption() const override { return m_dataCenter.getAveragePowerConsumption(); }
     double getTotalPowerConsumption() const override { return m_dataCenter.getTotalPowerConsumption(); }
     size_t getNumberOfSLAViolations() const override { return m_dataCenter.getNumberOfSLAViolations(); }
+    double getAveragePlacementDelay() const override { return m_dataCenter.getAveragePlacementDelay(); }
+    double getMaxPlacementDelay() const override { return m_dataCenter.getMaxPlacementDelay(); }
+    double getArrivalRate() const override { return m_dataCenter.getArrivalRate(); }
+    double getLastSolveTime() const override { return m_dataCenter.getLastSolveTime(); }
+    size_t getPlacementCacheLookups() const override { return m_dataCenter.getPlacementCacheStatistics().lookups; }
+    size_t getPlacementCacheHits() const override { return m_dataCenter.getPlacementCacheStatistics().hits; }
+    size_t getConsolidationMigrationCount() const override { return m_dataCenter.getConsolidationMigrationCount(); }
+    size_t getClusteredPlacementCount() const override { return m_dataCenter.getPlacementClusteringStatistics().runs; }
+    size_t getActiveClusterCount() const override { return m_dataCenter.getPlacementClusteringStatistics().activeClusters; }
+    size_t getClusterCount() const override { return m_dataCenter.getPlacementClusteringStatistics().clusters; }
 
     // ISimulationConfiguration
     void setPlacementStrategy(IPlacementStrategy *strategy) override { m_dataCenter.setPlacementStrategy(strategy); }
     size_t getBundleSize() const override { return m_dataCenter.getBundleSize(); }
     IPlacementStrategy *getPlacementStrategy() const override { return m_dataCenter.getPlacementStrategy(); }
     void setOutputFile(const std::string &filename) override;
+    void setMigrationSelectionPolicy(MigrationSelectionPolicy policy) override { m_dataCenter.setMigrationSelectionPolicy(policy); }
+    MigrationSelectionPolicy getMigrationSelectionPolicy() const override { return m_dataCenter.getMigrationSelectionPolicy(); }
+    void setMaxBundleWait(double seconds) override { m_dataCenter.setMaxBundleWait(seconds); }
+    double getMaxBundleWait() const override { return m_dataCenter.getMaxBundleWait(); }
+    void setBundleSizingMode(BundleSizingMode mode) override { m_dataCenter.setBundleSizingMode(mode); }
+    BundleSizingMode getBundleSizingMode() const override { return m_dataCenter.getBundleSizingMode(); }
+    void setAdaptiveBundleLimits(size_t minSize, size_t maxSize) override { m_dataCenter.setAdaptiveBundleLimits(minSize, maxSize); }
+    size_t getAdaptiveBundleMinSize() const override { return m_dataCenter.getAdaptiveBundleMinSize(); }
+    size_t getAdaptiveBundleMaxSize() const override { return m_dataCenter.getAdaptiveBundleMaxSize(); }
+    void setTargetSolveTime(double seconds) override { m_dataCenter.setTargetSolveTime(seconds); }
+    double getTargetSolveTime() const override { return m_dataCenter.getTargetSolveTime(); }
+    void setEventBatching(bool enabled) override { m_eventBatching = enabled; }
+    bool isEventBatching() const override { return m_eventBatching; }
+    void setAsyncPlacement(bool enabled) override { m_dataCenter.setAsyncPlacement(enabled); }
+    bool isAsyncPlacement() const override { return m_dataCenter.isAsyncPlacement(); }
+    void setDecisionLatency(double seconds) override { m_dataCenter.setDecisionLatency(seconds); }
+    double getDecisionLatency() const override { return m_dataCenter.getDecisionLatency(); }
+    void setPlacementDeadline(double seconds) override { m_dataCenter.setPlacementDeadline(seconds); }
+    double getPlacementDeadline() const override { return m_dataCenter.getPlacementDeadline(); }
+    void setPlacementCache(bool enabled) override { m_dataCenter.setPlacementCache(enabled); }
+    bool isPlacementCache() const override { return m_dataCenter.isPlacementCache(); }
+    void setConsolidationInterval(double seconds) override { m_dataCenter.setConsolidationInterval(seconds); }
+    double getConsolidationInterval() const override { return m_dataCenter.getConsolidationInterval(); }
+    void setConsolidationBudget(double seconds) override { m_dataCenter.setConsolidationBudget(seconds); }
+    double getConsolidationBudget() const override { return m_dataCenter.getConsolidationBudget(); }
+    void setPlacementClustering(size_t clusterSize, const std::string &strategyName) override { m_dataCenter.setPlacementClustering(clusterSize, strategyName); }
+    size_t getPlacementClusterSize() const override { return m_dataCenter.getPlacementClusterSize(); }
+    std::string getPlacementClusterStrategy() const override { return m_dataCenter.getPlacementClusterStrategy(); }
 
     // In case we want external producers to push
     void pushEvent(const std::shared_ptr<IEvent> &evt);
@@ -54,6 +92,7 @@ private:
     StatisticsRecorder *m_recorder;
 
     std::atomic<bool> m_stop;
+    std::atomic<bool> m_eventBatching{true};
     std::thread m_thread;
     double m_currentTime;
 };
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include <condition_variable>
 #include <atomic>
 #include <memory>
+#include <vector>
 #include "events/IEvent.h"
 
 #include <iostream>
@@ -53,6 +54,30 @@ public:
         return true;
     }
 
+    // Consumer: pop the earliest event and every queued event with the same timestamp (blocks if empty)
+    // Returns false if terminated or queue is empty after terminate
+    bool popBatch(std::vector<std::shared_ptr<IEvent>> &outEvents)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cv.wait(lock, [this]
+                  { return m_terminate || !m_queue.empty(); });
+
+        if (m_terminate || m_queue.empty())
+        {
+            return false;
+        }
+
+        double time = m_queue.top()->getTime();
+        while (!m_queue.empty() && m_queue.top()->getTime() == time)
+        {
+            outEvents.push_back(m_queue.top());
+            m_queue.pop();
+            m_popCount++;
+        }
+
+        return true;
+    }
+
     // Terminate the queue
     void terminate()
     {
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include "PhysicalMachine.h"
+
+// Running aggregates over the turned on machines of a fleet.
+// The owner retracts a machine before mutating it and accumulates it again
+// afterwards, so every query is O(1) and never walks the fleet.
+class FleetStatistics
+{
+public:
+    static constexpr int CPU_BIN_COUNT = 5; // 20% wide CPU utilization bins
+
+    void add(const PhysicalMachine &pm) { accumulate(pm, 1.0); }
+    void remove(const PhysicalMachine &pm) { accumulate(pm, -1.0); }
+
+    void reset() { *this = FleetStatistics(); }
+
+    size_t getVMCount() const { return static_cast<size_t>(m_vmCount); }
+    size_t getTurnedOnMachineCount() const { return static_cast<size_t>(m_turnedOnCount); }
+
+    Resources getUsedResources() const { return m_used; }
+    Resources getTotalResources() const { return m_total; }
+
+    // Mean and standard deviation of the per machine utilization (in percent)
+    Resources getMeanUtilization() const
+    {
+        if (m_turnedOnCount == 0)
+            return Resources(0, 0, 0, 0, 0);
+        return m_utilizationSum / static_cast<double>(m_turnedOnCount);
+    }
+
+    Resources getUtilizationStdDev() const
+    {
+        if (m_turnedOnCount == 0)
+            return Resources(0, 0, 0, 0, 0);
+
+        const double n = static_cast<double>(m_turnedOnCount);
+        Resources mean = getMeanUtilization();
+        auto stddev = [n](double sumSq, double mu)
+        {
+            // Clamp the small negative values caused by the cancellation of the running sums
+            return std::sqrt(std::max(0.0, sumSq / n - mu * mu));
+        };
+        return Resources(stddev(m_utilizationSqSum.cpu, mean.cpu),
+                         stddev(m_utilizationSqSum.ram, mean.ram),
+                         stddev(m_utilizationSqSum.disk, mean.disk),
+                         stddev(m_utilizationSqSum.bandwidth, mean.bandwidth),
+                         stddev(m_utilizationSqSum.fpga, mean.fpga));
+    }
+
+    const std::array<long, CPU_BIN_COUNT> &getCPUBins() const { return m_cpuBins; }
+
+    double getTotalPowerConsumption() const { return m_powerSum; }
+
+    static int cpuBin(const PhysicalMachine &pm)
+    {
+        return std::max(0, std::min(CPU_BIN_COUNT - 1, static_cast<int>(pm.getUtilization().cpu / 20.0)));
+    }
+
+private:
+    void accumulate(const PhysicalMachine &pm, double sign)
+    {
+        // VM count covers every machine, the rest only the turned on ones
+        m_vmCount += static_cast<long>(sign * pm.getVirtualMachines().size());
+
+        if (!pm.isTurnedOn())
+            return;
+
+        Resources utilization = pm.getUtilization();
+        Resources utilizationSq(utilization.cpu * utilization.cpu, utilization.ram * utilization.ram, utilization.disk * utilization.disk,
+                                utilization.bandwidth * utilization.bandwidth, utilization.fpga * utilization.fpga);
+
+        m_turnedOnCount += static_cast<long>(sign);
+        m_utilizationSum += utilization * sign;
+        m_utilizationSqSum += utilizationSq * sign;
+        m_used += pm.getUsed() * sign;
+        m_total += pm.getTotal() * sign;
+        m_powerSum += pm.getPowerConsumption() * sign;
+        m_cpuBins[cpuBin(pm)] += static_cast<long>(sign);
+    }
+
+    long m_vmCount{0};
+    long m_turnedOnCount{0};
+    Resources m_utilizationSum;
+    Resources m_utilizationSqSum;
+    Resources m_used;
+    Resources m_total;
+    double m_powerSum{0.0};
+    std::array<long, CPU_BIN_COUNT> m_cpuBins{};
+};
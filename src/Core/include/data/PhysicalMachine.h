@@ -130,6 +130,9 @@ public:
 
     const std::vector<VirtualMachine *> &getVirtualMachines() const { return m_virtualMachines; }
 
+    // Points a copy of the machine to copies of its VMs, the usage is kept as is
+    void rebindVMs(const std::vector<VirtualMachine *> &vms) { m_virtualMachines = vms; }
+
     MachineUsageInfo getUsageInfo() const
     {
         return {m_ID, m_usedResources, m_totalResources};
@@ -34,6 +34,7 @@ public:
     }
 
     void setPMID(int pmID) { m_currentPMID = pmID; }
+    int getPMID() const { return m_currentPMID; }
 
     int getOldPMID() const
     {
@@ -45,6 +46,9 @@ public:
         return m_oldPMID;
     }
 
+    double getRequestTime() const { return m_requestTime; }
+    void setRequestTime(double requestTime) { m_requestTime = requestTime; }
+
     double getStartTime() const { return m_startTime; }
     void setStartTime(double startTime) { m_startTime = startTime; }
     double getDuration() const { return m_duration; }
@@ -61,6 +65,7 @@ public:
 
 private:
     int m_ID;
+    double m_requestTime{0.0};
     double m_startTime;
     double m_duration;
     bool m_isPlaced;
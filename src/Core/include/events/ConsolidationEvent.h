@@ -0,0 +1,22 @@
+#pragma once
+
+#include "IEvent.h"
+
+/**
+ * ConsolidationEvent runs the periodic consolidation pass over the whole fleet,
+ * see DataCenter::setConsolidationInterval.
+ */
+class ConsolidationEvent : public IEvent
+{
+public:
+    explicit ConsolidationEvent(double time)
+        : m_time(time)
+    {
+    }
+
+    double getTime() const override { return m_time; }
+    void accept(DataCenter &dc, SimulationEngine &engine) override;
+
+private:
+    double m_time;
+};
\ No newline at end of file
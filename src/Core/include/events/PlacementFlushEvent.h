@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstdint>
+#include "IEvent.h"
+
+/**
+ * PlacementFlushEvent places the pending bundle once its oldest
+ * request has waited the maximum wait, unless it was placed already.
+ */
+class PlacementFlushEvent : public IEvent
+{
+public:
+    PlacementFlushEvent(double time, uint64_t generation)
+        : m_time(time), m_generation(generation)
+    {
+    }
+
+    double getTime() const override { return m_time; }
+    void accept(DataCenter &dc, SimulationEngine &engine) override;
+
+    uint64_t getGeneration() const { return m_generation; }
+
+private:
+    double m_time;
+    uint64_t m_generation;
+};
\ No newline at end of file
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "IEvent.h"
+
+/**
+ * PlacementReadyEvent commits the decisions of an asynchronous placement
+ * at the simulated time they become available.
+ */
+class PlacementReadyEvent : public IEvent
+{
+public:
+    explicit PlacementReadyEvent(double time)
+        : m_time(time)
+    {
+    }
+
+    double getTime() const override { return m_time; }
+    void accept(DataCenter &dc, SimulationEngine &engine) override;
+
+private:
+    double m_time;
+};
\ No newline at end of file
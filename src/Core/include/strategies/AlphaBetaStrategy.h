@@ -16,6 +16,7 @@ public:
     void applyConfigFromUI() override;
     QWidget *createStatusWidget(QWidget *parent = nullptr) override;
     QString name() const override;
+    IPlacementStrategy *clone() const override;
 
 private:
     double m_alpha;
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <vector>
+#include "data/PhysicalMachine.h"
+#include "data/VirtualMachine.h"
+
+/**
+ * Chooses the PMs a search-based strategy considers for a bundle.
+ * Turned on PMs are all taken, or the best fitting ones when capped, followed by the
+ * cheapest turned off PMs that can host the largest VM of the bundle,
+ * extraMachineCoefficient of them per VM. Turned off PMs are kept in a pool sorted by
+ * power on cost once per fleet, so a call costs a pass over the fleet and no sort.
+ */
+class CandidateSelector
+{
+public:
+    void setExtraMachineCoefficient(double coefficient) { m_extraMachineCoefficient = coefficient; }
+    double getExtraMachineCoefficient() const { return m_extraMachineCoefficient; }
+
+    // Maximum number of turned on PMs among the candidates, 0 takes all of them
+    void setMaxTurnedOnCandidates(size_t count) { m_maxTurnedOn = count; }
+    size_t getMaxTurnedOnCandidates() const { return m_maxTurnedOn; }
+
+    // Falls back to the whole fleet when nothing is turned on and nothing fits
+    const std::vector<const PhysicalMachine *> &select(const std::vector<VirtualMachine *> &vms, const std::vector<PhysicalMachine> &machines);
+
+    static double calculatePowerOnCost(const PhysicalMachine &machine);
+
+private:
+    void sortPool(const std::vector<PhysicalMachine> &machines);
+    void selectTurnedOn(const std::vector<VirtualMachine *> &vms, const std::vector<PhysicalMachine> &machines);
+
+    double m_extraMachineCoefficient{1.0};
+    size_t m_maxTurnedOn{0};
+
+    // PM indices by increasing power on cost, valid for the fleet it was built from
+    std::vector<int> m_pool;
+    std::vector<int> m_poolIds; // PM ids of that fleet by position
+
+    std::vector<const PhysicalMachine *> m_candidates;
+    std::vector<std::pair<std::pair<int, double>, const PhysicalMachine *>> m_ranked; // scratch for the capped selection
+};
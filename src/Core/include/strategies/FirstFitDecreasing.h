@@ -15,6 +15,7 @@ public:
     void applyConfigFromUI() override;
     QWidget *createStatusWidget(QWidget *parent = nullptr) override;
     QString name() const override;
+    IPlacementStrategy *clone() const override;
 
 private:
     QWidget *m_configWidget{nullptr};
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "IPlacementStrategy.h"
+#include "BestFitDecreasing.h"
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Online placement in O(1) amortized per request, for very high arrival rates.
+ * Requests are classified harmonically over their dominant resource share of the
+ * largest PM: class k holds the shares in (1/(k+1), 1/k], the last class everything
+ * smaller. Each PM is dedicated to one class when it is opened, and every class keeps
+ * a list of open PMs. A request goes to the open PM of its class, a PM it does not fit
+ * is closed for the class, and a new PM is taken from the empty ones, turned on first.
+ * The lists persist across runs and are rebuilt from the fleet periodically, when
+ * departures have reopened space; every fit is checked against the fleet itself.
+ * A full scan is only the fallback when no class PM and no empty PM fits.
+ * Every few runs the bundle is also placed by BestFitDecreasing to sample the packing
+ * efficiency and the speedup relative to it.
+ */
+class HarmonicStrategy : public IPlacementStrategy
+{
+public:
+    HarmonicStrategy();
+    ~HarmonicStrategy() override;
+
+    Results run(const std::vector<VirtualMachine *> &newRequests, const std::vector<VirtualMachine *> &toMigrate, const std::vector<PhysicalMachine> &machines) override;
+    double getMigrationThreshold() override;
+    size_t getBundleSize() override;
+
+    QWidget *createConfigWidget(QWidget *parent = nullptr) override;
+    void applyConfigFromUI() override;
+    QWidget *createStatusWidget(QWidget *parent = nullptr) override;
+    QString name() const override;
+    IPlacementStrategy *clone() const override;
+
+    // PMs in use after BestFitDecreasing over PMs in use after this strategy, averaged over the samples
+    double getPackingEfficiency() const { return m_samples > 0 ? m_efficiencySum / m_samples : 0.0; }
+    double getSpeedup() const { return m_samples > 0 ? m_speedupSum / m_samples : 0.0; }
+    size_t getSampleCount() const { return m_samples; }
+
+private:
+    int classify(const Resources &need) const;
+    bool fits(int position, const Resources &need, const std::vector<PhysicalMachine> &machines) const;
+    int place(const Resources &need, int excluded, const std::vector<PhysicalMachine> &machines);
+    void commit(int position, const Resources &need);
+    void resync(const std::vector<PhysicalMachine> &machines);
+    bool needsResync(const std::vector<PhysicalMachine> &machines) const;
+    void sampleEfficiency(const std::vector<VirtualMachine *> &newRequests, const std::vector<VirtualMachine *> &toMigrate, const std::vector<PhysicalMachine> &machines, const Results &results, double seconds);
+
+    int m_classCount{6};
+    size_t m_resyncInterval{100}; // runs between rebuilds of the lists
+    size_t m_sampleInterval{50};  // runs between comparisons with BestFitDecreasing, 0 never compares
+    double m_MST{0.9};            // Migration Start Threshold
+    size_t m_bundleSize{10};
+
+    // Packing state, by PM position in the fleet
+    Resources m_reference;                      // capacity the shares are taken of
+    std::vector<int> m_position;                // PM id -> position, -1 for unknown ids
+    std::vector<int> m_machineClass;            // class a PM is dedicated to, 0 for empty PMs
+    std::vector<std::vector<int>> m_open;       // per class, open PMs with the current one at the back
+    std::vector<int> m_emptyOn, m_emptyOff;     // empty PMs, the turned on ones are opened first
+    std::unordered_map<int, Resources> m_added; // requests placed by the running bundle, per position
+    size_t m_runs{0};
+
+    // Statistics
+    size_t m_resyncs{0};
+    size_t m_fallbacks{0}; // requests that needed the full scan
+    size_t m_samples{0};
+    double m_efficiencySum{0};
+    double m_speedupSum{0};
+    BestFitDecreasing m_baseline;
+
+    QWidget *m_configWidget{nullptr};
+    QWidget *m_statusWidget{nullptr};
+    QSpinBox *m_classCountSpin{nullptr};
+    QSpinBox *m_resyncIntervalSpin{nullptr};
+    QSpinBox *m_sampleIntervalSpin{nullptr};
+    QDoubleSpinBox *m_MSTSpin{nullptr};
+    QSpinBox *m_bundleSizeSpin{nullptr};
+};
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <ilcplex/ilocplex.h>
+#include <atomic>
+#include <limits>
+#include <vector>
+#include "data/PhysicalMachine.h"
+#include "data/VirtualMachine.h"
+
+struct ILPParameters
+{
+    double mu;                                // Migration cost
+    double tau;                               // Target Utilization After Migration
+    double beta;                              // Expected Utilization Scaler for New Requests
+    double gamma;                             // Expected Utilization Scaler for Migrations
+    double timeLimit;                         // seconds
+    double gap;                               // relative MIP gap to stop at
+    double tamShare{1.0};                     // fraction of the TAM allowance given to this problem, < 1 for a subproblem
+    int threads{0};                           // CPLEX threads, 0 lets CPLEX decide
+    long nodeLimit{0};                        // branch and bound nodes, 0 for no limit
+    const std::atomic<bool> *cancel{nullptr}; // aborts the search with the incumbent once set
+};
+
+struct ILPSolution
+{
+    bool feasible{false}; // CPLEX found a solution, otherwise the machines below are the best fit start
+    double cost{0.0};
+    std::vector<int> newcomerMachines;  // index into the machines of the bundle, -1 if unassigned
+    std::vector<int> migrationMachines; // index into the machines of the bundle, -1 if the VM stays
+    double buildSeconds{0.0};           // skeleton (re)build and per bundle updates
+    double solveSeconds{0.0};
+    double gap{std::numeric_limits<double>::quiet_NaN()}; // relative MIP gap of the returned solution
+    long nodes{0};                                        // branch and bound nodes processed
+    bool optimal{false};                                  // proven within the MIP gap, not stopped by a limit
+};
+
+/**
+ * Placement ILP kept alive across bundles.
+ * The environment, the variables and the constraints are built once for a number of
+ * PM, newcomer and migration slots and extracted into CPLEX. Every bundle only updates
+ * the objective and constraint coefficients, the free capacities and the variable
+ * bounds; slots the bundle does not use are fixed to 0. The skeleton is rebuilt with
+ * larger capacities when a bundle does not fit.
+ * Only (request, PM) pairs the free capacity of the PM can host are released, so
+ * presolve drops every other assignment variable, and each released pair is tied
+ * to the PM activation by its own x <= y row.
+ */
+class ILPModel
+{
+public:
+    ILPModel();
+    ~ILPModel();
+
+    ILPSolution solve(const std::vector<const PhysicalMachine *> &machines,
+                      const std::vector<VirtualMachine *> &newRequests, const std::vector<VirtualMachine *> &toMigrate,
+                      const ILPParameters &parameters);
+
+private:
+    void build(int machineSlots, int newcomerSlots, int migrationSlots);
+    void update(const std::vector<const PhysicalMachine *> &machines, int I,
+                const std::vector<VirtualMachine *> &newRequests, const std::vector<VirtualMachine *> &toMigrate,
+                const ILPParameters &parameters);
+
+    // Best fit of the bundle on the chosen machines, used as MIP start and as fallback
+    void bestFit(const std::vector<const PhysicalMachine *> &machines, int I,
+                 const std::vector<VirtualMachine *> &newRequests, const std::vector<VirtualMachine *> &toMigrate,
+                 const ILPParameters &parameters, std::vector<int> &newcomerMachines, std::vector<int> &migrationMachines) const;
+    void setStart(int I, const std::vector<int> &newcomerMachines, const std::vector<int> &migrationMachines);
+
+    IloEnv m_env;
+    IloModel m_model;
+    IloCplex m_cplex;
+    IloObjective m_objective;
+
+    IloArray<IloBoolVarArray> m_xNewcomers;   // [newcomer][machine]
+    IloArray<IloBoolVarArray> m_xMigrations;  // [migration][machine]
+    IloBoolVarArray m_y;                      // PM activation status
+    IloBoolVarArray m_migrate;                // migration request is actually migrated
+
+    IloRangeArray m_assignment;               // each newcomer on one PM
+    IloArray<IloRangeArray> m_capacity;       // [dimension][machine]
+    IloArray<IloRangeArray> m_newcomerLinks;  // [newcomer][machine] x <= y
+    IloArray<IloRangeArray> m_migrationLinks; // [migration][machine] x <= y
+    IloRangeArray m_migrationAssignment;      // each migrated request on one PM
+    IloRange m_targetUtilization;             // TAM: load left on the overcommitted PM
+
+    const std::atomic<bool> *m_cancel{nullptr}; // token of the running solve, polled by the MIP info callback
+
+    int m_machineSlots{0};
+    int m_newcomerSlots{0};
+    int m_migrationSlots{0};
+
+    // Slots used by the previous bundle and the pairs it released, only the difference is updated
+    int m_usedMachines{0};
+    int m_usedNewcomers{0};
+    int m_usedMigrations{0};
+    std::vector<char> m_assignmentReleased; // newcomer slots whose assignment row is [1, 1]
+    std::vector<char> m_newcomerReleased;   // newcomer * machine slots
+    std::vector<char> m_migrationReleased;  // migration * machine slots
+};
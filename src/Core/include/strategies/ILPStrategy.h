@@ -1,5 +1,10 @@
 #pragma once
 #include "IPlacementStrategy.h"
+#include "CandidateSelector.h"
+
+class ILPModel;
+struct ILPParameters;
+struct ILPSolution;
 
 class ILPStrategy : public IPlacementStrategy
 {
@@ -8,6 +13,7 @@ public:
     ~ILPStrategy() override;
 
     Results run(const std::vector<VirtualMachine *> &newRequests, const std::vector<VirtualMachine *> &toMigrate, const std::vector<PhysicalMachine> &machines) override;
+    Results runBudgeted(const std::vector<VirtualMachine *> &newRequests, const std::vector<VirtualMachine *> &toMigrate, const std::vector<PhysicalMachine> &machines, const PlacementBudget &budget) override;
     double getMigrationThreshold() override;
     size_t getBundleSize() override;
 
@@ -15,13 +21,14 @@ public:
     void applyConfigFromUI() override;
     virtual QWidget *createStatusWidget(QWidget *parent = nullptr) override;
     QString name() const override;
+    IPlacementStrategy *clone() const override;
 
 protected:
-    std::vector<PhysicalMachine *> m_chosenMachines;
-    std::vector<PhysicalMachine *> m_turnedOffMachines;
-    size_t m_chosenMachineCount;
-    void ChooseMachines(std::vector<PhysicalMachine> &machines, const std::vector<VirtualMachine *> &requests, const std::vector<VirtualMachine *> &migrations);
-    double CalculatePowerOnCost(PhysicalMachine &machine);
+    CandidateSelector m_candidateSelector;
+    std::vector<const PhysicalMachine *> m_chosenMachines;
+    void ChooseMachines(const std::vector<PhysicalMachine> &machines, const std::vector<VirtualMachine *> &requests, const std::vector<VirtualMachine *> &migrations);
+    // Splits the bundle and the chosen PMs into m_subproblemCount groups solved concurrently
+    ILPSolution solveDecomposed(const std::vector<VirtualMachine *> &newRequests, const std::vector<VirtualMachine *> &toMigrate, const ILPParameters &parameters);
 
     double m_Mu;    // Migration cost
     double m_Tau;   // Target Utilization After Migration
@@ -29,11 +36,22 @@ protected:
     double m_Gamma; // Expected Utilization Scaler for Migrations
     double m_MST;   // Migration Start Threshold
     double m_extraMachineCoefficient;
-    int m_maximumRequestsInPM;
+    int m_maxTurnedOnCandidates{200}; // 0 takes every turned on PM
+    double m_gap{1e-4};               // Relative MIP gap, CPLEX default
+    double m_timeLimit{60.0};         // seconds, a placement budget may shorten it
 
     double m_lastCost;
     bool m_lastFeasibility;
 
+    // Persistent CPLEX model, updated per bundle instead of rebuilt
+    ILPModel *m_model;
+    double m_lastBuildTime{0.0};
+    double m_lastSolveTime{0.0};
+
+    // Decomposition of large bundles, one persistent model per subproblem
+    int m_subproblemCount{1};
+    std::vector<ILPModel *> m_subModels;
+
     size_t m_bundleSize;
 
     QDoubleSpinBox *m_MuSpin{nullptr};
@@ -42,7 +60,9 @@ protected:
     QDoubleSpinBox *m_GammaSpin{nullptr};
     QDoubleSpinBox *m_MSTSpin{nullptr};
     QDoubleSpinBox *m_extraMachineCoefficientSpin{nullptr};
-    QSpinBox *m_maximumRequestsInPMSpin{nullptr};
+    QSpinBox *m_maxTurnedOnCandidatesSpin{nullptr};
+    QDoubleSpinBox *m_gapSpin{nullptr};
+    QSpinBox *m_subproblemCountSpin{nullptr};
     QWidget *m_configWidget{nullptr};
     QWidget *m_statusWidget{nullptr};
 };
\ No newline at end of file
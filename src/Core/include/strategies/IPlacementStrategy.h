@@ -12,6 +12,7 @@
 #include <QFileDialog>
 #include "data/PhysicalMachine.h"
 #include "data/VirtualMachine.h"
+#include "PlacementBudget.h"
 
 // TODO: Check it
 struct PlacementDecision
@@ -24,6 +25,7 @@ struct Results
 {
     std::vector<PlacementDecision> placementDecision;
     std::vector<PlacementDecision> migrationDecision;
+    PlacementQuality quality; // filled by runBudgeted
 };
 
 class IPlacementStrategy
@@ -34,6 +36,17 @@ public:
     // Decide how to place a batch of VMs
     virtual Results run(const std::vector<VirtualMachine *> &newRequests, const std::vector<VirtualMachine *> &toMigrate, const std::vector<PhysicalMachine> &machines) = 0;
 
+    // Anytime variant: stops within the budget and returns the best decisions found so far with
+    // their quality. Strategies that cannot be interrupted run to completion and report it
+    virtual Results runBudgeted(const std::vector<VirtualMachine *> &newRequests, const std::vector<VirtualMachine *> &toMigrate, const std::vector<PhysicalMachine> &machines, const PlacementBudget &budget)
+    {
+        BudgetTracker tracker(budget);
+        Results results = run(newRequests, toMigrate, machines);
+        results.quality.iterations = 1;
+        results.quality.seconds = tracker.elapsed();
+        return results;
+    }
+
     virtual double getMigrationThreshold() = 0;
     virtual size_t getBundleSize() = 0;
 
@@ -50,4 +63,8 @@ public:
 
     // Return a human-readable name for the strategy
     virtual QString name() const = 0;
+
+    // A new instance with the settings of this one and none of its run state, for runs in parallel.
+    // nullptr when the strategy cannot be copied
+    virtual IPlacementStrategy *clone() const { return nullptr; }
 };
\ No newline at end of file
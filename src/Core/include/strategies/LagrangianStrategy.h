@@ -0,0 +1,103 @@
+#pragma once
+
+#include "IPlacementStrategy.h"
+#include "CandidateSelector.h"
+#include <vector>
+
+/**
+ * Placement by Lagrangian relaxation of the ILPStrategy cost model, without CPLEX.
+ * The capacity rows are moved into the objective with one multiplier per PM and
+ * dimension, which leaves every request to pick its cheapest PM on its own and the
+ * migrations to a covering knapsack on the TAM row. The multipliers follow the
+ * subgradient of the capacity violation, and every iteration the relaxed choices are
+ * rounded into a capacity feasible placement by a greedy pass on the reduced costs,
+ * followed by a repair that empties newly turned on PMs when that is cheaper.
+ * The best rounded placement is returned, with the gap to the Lagrangian bound.
+ */
+class LagrangianStrategy : public IPlacementStrategy
+{
+public:
+    LagrangianStrategy();
+    ~LagrangianStrategy() override;
+
+    Results run(const std::vector<VirtualMachine *> &newRequests, const std::vector<VirtualMachine *> &toMigrate, const std::vector<PhysicalMachine> &machines) override;
+    Results runBudgeted(const std::vector<VirtualMachine *> &newRequests, const std::vector<VirtualMachine *> &toMigrate, const std::vector<PhysicalMachine> &machines, const PlacementBudget &budget) override;
+    double getMigrationThreshold() override;
+    size_t getBundleSize() override;
+
+    QWidget *createConfigWidget(QWidget *parent = nullptr) override;
+    void applyConfigFromUI() override;
+    QWidget *createStatusWidget(QWidget *parent = nullptr) override;
+    QString name() const override;
+    IPlacementStrategy *clone() const override;
+
+private:
+    // A request of the bundle, newcomers first and then migrations
+    struct Request
+    {
+        Resources usage;             // capacity it takes
+        double cpuCost;              // CPU cores the utilization cost is charged on
+        double scaler;               // beta for newcomers, gamma for migrations
+        double tamCPU;               // CPU the migration removes from the TAM row, 0 for newcomers
+        std::vector<int> candidates; // PMs its usage fits on, as in the released ILP pairs
+    };
+
+    struct Placement
+    {
+        std::vector<int> machine; // candidate PM per request, -1 if unassigned or the VM stays
+        double cost;
+    };
+
+    void prepare(const std::vector<VirtualMachine *> &newRequests, const std::vector<VirtualMachine *> &toMigrate);
+    double reducedCost(int j, int i) const;
+    double relax(std::vector<int> &choice, std::vector<Resources> &load) const;
+    Placement round(const std::vector<int> &choice) const;
+    double placementCost(const std::vector<int> &machine) const;
+
+    // Cost model, as in ILPStrategy
+    double m_Mu{250};    // Migration cost
+    double m_Tau{0.85};  // Target Utilization After Migration
+    double m_Beta{1.0};  // Expected Utilization Scaler for New Requests
+    double m_Gamma{1.0}; // Expected Utilization Scaler for Migrations
+    double m_MST{0.9};   // Migration Start Threshold
+    double m_extraMachineCoefficient{5.0};
+    int m_maxTurnedOnCandidates{200}; // 0 takes every turned on PM
+    size_t m_bundleSize{10};
+
+    // Subgradient search
+    int m_maxIterations{100};
+    double m_initialStep{2.0}; // Polyak step scaler, halved when the bound stalls
+    int m_stallIterations{5};  // iterations without a better bound before halving the step
+    double m_gap{1e-3};        // relative gap between the best placement and the bound to stop at
+
+    CandidateSelector m_candidateSelector;
+    std::vector<const PhysicalMachine *> m_chosenMachines;
+
+    // Bundle data, rebuilt per run
+    int m_newcomerCount{0};
+    double m_tamExcess{0}; // migrated CPU the TAM row asks for
+    std::vector<Request> m_requests;
+    std::vector<Resources> m_free;        // free capacity per chosen PM, CPU clamped at 0
+    std::vector<double> m_powerOnCost;    // y coefficient per chosen PM
+    std::vector<double> m_unitCPUCost;    // utilization cost of one core per chosen PM
+    std::vector<Resources> m_multipliers; // capacity multipliers per chosen PM
+
+    double m_lastCost{0};
+    double m_lastBound{0};
+    int m_lastIterations{0};
+
+    QWidget *m_configWidget{nullptr};
+    QWidget *m_statusWidget{nullptr};
+    QDoubleSpinBox *m_MuSpin{nullptr};
+    QDoubleSpinBox *m_TauSpin{nullptr};
+    QDoubleSpinBox *m_BetaSpin{nullptr};
+    QDoubleSpinBox *m_GammaSpin{nullptr};
+    QDoubleSpinBox *m_MSTSpin{nullptr};
+    QDoubleSpinBox *m_extraMachineCoefficientSpin{nullptr};
+    QSpinBox *m_maxTurnedOnCandidatesSpin{nullptr};
+    QSpinBox *m_bundleSizeSpin{nullptr};
+    QSpinBox *m_maxIterationsSpin{nullptr};
+    QDoubleSpinBox *m_initialStepSpin{nullptr};
+    QSpinBox *m_stallIterationsSpin{nullptr};
+    QDoubleSpinBox *m_gapSpin{nullptr};
+};
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "IPlacementStrategy.h"
+#include "PlacementCostModel.h"
+#include <random>
+#include <vector>
+
+/**
+ * Consolidation by simulated annealing over the standing placement.
+ * Newcomers are first put on their cheapest fitting PM, then every VM that is not
+ * migrating may be moved to another PM or swapped with a VM of another PM. A move
+ * touches two PMs only, so its delta is priced in O(1) with the shared cost model
+ * (power, overload, fragmentation) plus the migration cost of leaving the VM's
+ * original PM. Moves that break the capacity are never taken. The search stops at
+ * the time or iteration budget and returns the best placement it visited; VMs that
+ * ended up away from their PM are emitted as migration decisions.
+ * DataCenter also runs it periodically on the whole fleet, see setConsolidationInterval.
+ */
+class LocalSearchStrategy : public IPlacementStrategy
+{
+public:
+    LocalSearchStrategy();
+    ~LocalSearchStrategy() override;
+
+    Results run(const std::vector<VirtualMachine *> &newRequests, const std::vector<VirtualMachine *> &toMigrate, const std::vector<PhysicalMachine> &machines) override;
+    Results runBudgeted(const std::vector<VirtualMachine *> &newRequests, const std::vector<VirtualMachine *> &toMigrate, const std::vector<PhysicalMachine> &machines, const PlacementBudget &budget) override;
+    double getMigrationThreshold() override;
+    size_t getBundleSize() override;
+
+    QWidget *createConfigWidget(QWidget *parent = nullptr) override;
+    void applyConfigFromUI() override;
+    QWidget *createStatusWidget(QWidget *parent = nullptr) override;
+    QString name() const override;
+    IPlacementStrategy *clone() const override;
+
+private:
+    // A VM the search may move
+    struct Item
+    {
+        VirtualMachine *vm;
+        Resources usage;
+        int origin;  // PM position it starts on, -1 for newcomers
+        int machine; // current PM position
+    };
+
+    int placeNewcomer(const Resources &usage, std::vector<Resources> &load, std::vector<int> &count, std::vector<double> &cost, const PlacementCostModel &model) const;
+
+    PlacementCostWeights m_weights;
+    double m_timeLimit{0.2};           // seconds, when the caller's budget has no wall-clock limit
+    size_t m_maxIterations{1000000};
+    double m_initialTemperature{50.0}; // in cost units, a move this much worse is accepted with probability 1/e
+    double m_cooling{0.9999};          // temperature factor per iteration
+    double m_swapProbability{0.3};
+    double m_MST{0.9};                 // Migration Start Threshold
+    size_t m_bundleSize{10};
+
+    std::mt19937 m_rng{42};
+
+    // Last run
+    double m_lastInitialCost{0};
+    double m_lastCost{0};
+    size_t m_lastIterations{0};
+    size_t m_lastAccepted{0};
+    size_t m_lastMigrations{0};
+
+    QWidget *m_configWidget{nullptr};
+    QWidget *m_statusWidget{nullptr};
+    QDoubleSpinBox *m_MuSpin{nullptr};
+    QDoubleSpinBox *m_overloadWeightSpin{nullptr};
+    QDoubleSpinBox *m_overloadThresholdSpin{nullptr};
+    QDoubleSpinBox *m_fragmentationWeightSpin{nullptr};
+    QDoubleSpinBox *m_timeLimitSpin{nullptr};
+    QSpinBox *m_maxIterationsSpin{nullptr};
+    QDoubleSpinBox *m_initialTemperatureSpin{nullptr};
+    QDoubleSpinBox *m_coolingSpin{nullptr};
+    QDoubleSpinBox *m_swapProbabilitySpin{nullptr};
+    QDoubleSpinBox *m_MSTSpin{nullptr};
+    QSpinBox *m_bundleSizeSpin{nullptr};
+};
@@ -17,6 +17,7 @@ public:
     void applyConfigFromUI() override;
     QWidget *createStatusWidget(QWidget *parent = nullptr) override;
     QString name() const override;
+    IPlacementStrategy *clone() const override;
 
 private:
     double m_ial{0.8};
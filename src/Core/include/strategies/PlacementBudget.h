@@ -0,0 +1,63 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <limits>
+
+// Limits of one budgeted placement run, a zero limit is not enforced
+struct PlacementBudget
+{
+    double wallSeconds{0.0};                  // wall-clock time the run may take
+    size_t operations{0};                     // strategy specific work units: swarm iterations, B&B nodes, ...
+    const std::atomic<bool> *cancel{nullptr}; // owned by the caller, the run stops at its next check once set
+};
+
+// What a budgeted run returns next to its decisions
+struct PlacementQuality
+{
+    double objective{std::numeric_limits<double>::quiet_NaN()}; // objective of the returned incumbent in the strategy's own units
+    double gap{std::numeric_limits<double>::quiet_NaN()};       // relative gap to the strategy's bound, NaN without a bound
+    size_t iterations{0};                                       // work units spent, in the units of PlacementBudget::operations
+    double seconds{0.0};
+    bool complete{true}; // false when the budget or the cancellation stopped the search
+};
+
+// Clock of one run against its budget, checked by the strategies between units of work
+class BudgetTracker
+{
+public:
+    explicit BudgetTracker(const PlacementBudget &budget)
+        : m_budget(budget), m_start(std::chrono::steady_clock::now())
+    {
+    }
+
+    double elapsed() const
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count();
+    }
+
+    // Seconds left, infinity without a wall-clock limit
+    double remaining() const
+    {
+        if (m_budget.wallSeconds <= 0)
+            return std::numeric_limits<double>::infinity();
+        return m_budget.wallSeconds - elapsed();
+    }
+
+    bool cancelled() const
+    {
+        return m_budget.cancel && m_budget.cancel->load(std::memory_order_relaxed);
+    }
+
+    bool exhausted(size_t operations) const
+    {
+        return cancelled() || (m_budget.operations > 0 && operations >= m_budget.operations) || remaining() <= 0;
+    }
+
+    const PlacementBudget &budget() const { return m_budget; }
+
+private:
+    PlacementBudget m_budget;
+    std::chrono::steady_clock::time_point m_start;
+};
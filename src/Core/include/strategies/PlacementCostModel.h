@@ -0,0 +1,108 @@
+#pragma once
+
+#include "IPlacementStrategy.h"
+#include <cstddef>
+#include <vector>
+
+// Cost of a decision against the fleet it was taken on, every term is a change from the snapshot
+struct PlacementCost
+{
+    double power{0.0};         // fleet power draw, power on costs included
+    double overload{0.0};      // weighted utilization above the overload threshold
+    double migration{0.0};     // weighted migrations
+    double fragmentation{0.0}; // weighted capacity stranded on turned on PMs
+    size_t violations{0};      // PMs the decision adds load to that end up past their capacity
+    size_t unplaced{0};        // decisions without a PM
+
+    double total() const { return power + overload + migration + fragmentation; }
+};
+
+// Weights of the cost terms, in units of the PM power coefficients
+struct PlacementCostWeights
+{
+    double power{1.0};
+    double overload{1000.0};       // per unit of utilization above the threshold, per dimension
+    double overloadThreshold{0.9}; // utilization the overload term starts at
+    double migration{250.0};       // per migration, as the ILP Mu
+    double fragmentation{100.0};   // per PM, on the spread between its most and least free dimension
+};
+
+/**
+ * One cost model for placement decisions, so that strategies, the portfolio and offline
+ * analysis compare decisions in the same currency. The fleet snapshot is copied once into
+ * per dimension arrays. A decision is evaluated on the PMs it touches only, and the cost of
+ * placing one VM is computed for the whole fleet in a single pass over the arrays.
+ *
+ * Loads are the current usage of the VMs, newcomers included, as PhysicalMachine::addVM
+ * allocates them and as DataCenter validates and repairs decisions. A PM is on after the
+ * decision when it hosts a VM, a turned on PM that ends up empty is turned off as
+ * PhysicalMachine::removeVM does.
+ */
+class PlacementCostModel
+{
+public:
+    using Weights = PlacementCostWeights;
+
+    explicit PlacementCostModel(const std::vector<PhysicalMachine> &machines, const Weights &weights = Weights());
+
+    // Position of the PM in the snapshot, -1 if it is not there
+    int indexOf(int pmId) const;
+    size_t size() const { return m_ids.size(); }
+    const Weights &getWeights() const { return m_weights; }
+
+    // Placement and migration decisions of a strategy
+    PlacementCost evaluate(const Results &results) const;
+
+    // Many candidate decisions on the same snapshot, split over threads (0 uses every core)
+    std::vector<PlacementCost> evaluateBatch(const std::vector<Results> &candidates, unsigned threads = 0) const;
+
+    // Weighted cost of moving a load from one PM to another on the snapshot, -1 for no PM on either
+    // side. Infinity when the target cannot hold it
+    double moveCost(const Resources &load, int fromPmId, int toPmId) const;
+
+    // Weighted cost of placing the load on each PM of the snapshot, infinity where it does not fit
+    void placementCosts(const Resources &load, std::vector<double> &costs) const;
+
+    // Weighted power, overload and fragmentation of PM i at a load and VM count other than the
+    // snapshot's, O(1). Searches that keep their own loads price their moves with it
+    double machineCost(size_t i, const Resources &used, int vmCount) const;
+
+    // Snapshot of PM i
+    Resources used(size_t i) const;
+    Resources total(size_t i) const;
+    int vmCount(size_t i) const { return m_vmCount[i]; }
+    int id(size_t i) const { return m_ids[i]; }
+
+private:
+    struct Touched
+    {
+        Resources delta;
+        int vmDelta{0};
+    };
+
+    struct Terms
+    {
+        double power{0.0};
+        double overload{0.0};
+        double fragmentation{0.0};
+        bool violated{false};
+    };
+
+    Terms terms(size_t i, const Resources &used, int vmCount) const;
+    void accumulate(PlacementCost &cost, size_t i, const Touched &touched) const;
+
+    Weights m_weights;
+
+    std::vector<int> m_ids;
+    std::vector<int> m_index; // PM id -> position, -1 for unknown ids
+
+    // Fleet state, one array per field
+    std::vector<double> m_usedCPU, m_usedRAM, m_usedDisk, m_usedBandwidth, m_usedFPGA;
+    std::vector<double> m_totalCPU, m_totalRAM, m_totalDisk, m_totalBandwidth, m_totalFPGA;
+    std::vector<int> m_vmCount;
+    std::vector<char> m_turnedOn;
+    std::vector<double> m_powerOnCost, m_powerCPU, m_powerFPGA;
+
+    // Terms of every PM on the snapshot, the baseline of the deltas
+    std::vector<Terms> m_base;
+};
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "IPlacementStrategy.h"
+#include "PlacementCostModel.h"
+#include <QCheckBox>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+/**
+ * Races several strategies on the same bundle and commits the best result.
+ * Every member runs on its own thread against the same machines with the caller's
+ * budget, members still running at the deadline are cancelled and return their
+ * incumbent. Results are scored with the shared PlacementCostModel, after the capacity
+ * check and the number of unplaced requests. Results past the deadline only count when nothing
+ * arrived in time. Wins and latencies are kept per member.
+ */
+class PortfolioStrategy : public IPlacementStrategy
+{
+public:
+    struct MemberStatistics
+    {
+        QString name;
+        size_t runs{0};
+        size_t wins{0};
+        double totalSeconds{0.0};
+        double maxSeconds{0.0};
+    };
+
+    PortfolioStrategy();
+    ~PortfolioStrategy() override;
+
+    Results run(const std::vector<VirtualMachine *> &newRequests, const std::vector<VirtualMachine *> &toMigrate, const std::vector<PhysicalMachine> &machines) override;
+    Results runBudgeted(const std::vector<VirtualMachine *> &newRequests, const std::vector<VirtualMachine *> &toMigrate, const std::vector<PhysicalMachine> &machines, const PlacementBudget &budget) override;
+    double getMigrationThreshold() override;
+    size_t getBundleSize() override;
+
+    QWidget *createConfigWidget(QWidget *parent = nullptr) override;
+    void applyConfigFromUI() override;
+    QWidget *createStatusWidget(QWidget *parent = nullptr) override;
+    QString name() const override;
+    IPlacementStrategy *clone() const override;
+
+    std::vector<MemberStatistics> getMemberStatistics() const;
+
+private:
+    struct Member
+    {
+        IPlacementStrategy *strategy{nullptr};
+        MemberStatistics statistics;
+    };
+
+    // Lower is better: capacity feasible first, then fewer unplaced requests, then cost
+    struct Score
+    {
+        bool feasible{false};
+        size_t unplaced{0};
+        double cost{0.0};
+
+        bool operator<(const Score &rhs) const;
+    };
+
+    // Queues the member set, applyPendingMembers swaps it in when no race is running
+    void setMembers(const std::vector<QString> &names);
+    void applyPendingMembers();
+    Score score(const Results &results, const std::vector<VirtualMachine *> &newRequests, const PlacementCostModel &model) const;
+
+    std::vector<Member> m_members;
+    std::vector<QString> m_pendingMembers;
+    bool m_membersPending{false};
+    mutable std::mutex m_statisticsMutex; // the statistics and the pending member set
+    std::atomic<bool> m_cancel{false}; // shared by the members of the running race
+
+    double m_Mu{250};  // Migration weight of the scoring model, as in ILPStrategy
+    double m_MST{0.9}; // Migration Start Threshold
+    size_t m_bundleSize{10};
+
+    QWidget *m_configWidget{nullptr};
+    QWidget *m_statusWidget{nullptr};
+    std::vector<std::pair<QString, QCheckBox *>> m_memberChecks;
+    QDoubleSpinBox *m_MuSpin{nullptr};
+    QDoubleSpinBox *m_MSTSpin{nullptr};
+    QSpinBox *m_bundleSizeSpin{nullptr};
+};
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cmath>
+#include "data/PhysicalMachine.h"
+
+// CPU cost of adding cpu cores to a PM in the placement cost model. It falls with the current
+// utilization up to 45% and rises beyond it, so half loaded PMs are the cheapest to fill
+inline double utilizationCost(const PhysicalMachine &machine, double cpu)
+{
+    double nCPUUtilization = floor(((machine.getFreeResources().cpu * -1.0) / machine.getTotal().cpu) * 100.0 + 100);
+    if (nCPUUtilization < 45)
+    {
+        return machine.getPowerConsumptionCPU() * (300 - 4 * nCPUUtilization) * cpu;
+    }
+    return machine.getPowerConsumptionCPU() * (4 * nCPUUtilization - 60) * cpu;
+}
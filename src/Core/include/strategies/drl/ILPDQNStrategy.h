@@ -12,7 +12,8 @@ public:
     ILPDQNStrategy();
     virtual ~ILPDQNStrategy() override;
 
-    virtual Results run(const std::vector<VirtualMachine *> &newRequests, const std::vector<VirtualMachine *> &toMigrate, const std::vector<PhysicalMachine> &machines) override;
+    // ILPStrategy::run forwards here, so both entry points pick an action first
+    virtual Results runBudgeted(const std::vector<VirtualMachine *> &newRequests, const std::vector<VirtualMachine *> &toMigrate, const std::vector<PhysicalMachine> &machines, const PlacementBudget &budget) override;
     double getMigrationThreshold() override;
 
     void setDataCenter(DataCenter *dc) { m_dataCenter = dc; }
@@ -22,6 +23,7 @@ public:
     virtual void applyConfigFromUI() override;
     virtual QWidget *createStatusWidget(QWidget *parent = nullptr) override;
     QString name() const override;
+    IPlacementStrategy *clone() const override;
 
 protected:
     DataCenter *m_dataCenter;
@@ -36,7 +38,6 @@ protected:
 
     // DQN agent
     DQNAgent *m_agent;
-    double m_gap;
 
     QWidget *m_configWidget{nullptr};
     QWidget *m_statusWidget{nullptr};
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "../IPlacementStrategy.h"
+#include "../CandidateSelector.h"
+#include <vector>
+#include <random>
+
+class PAPSOFitness;
+
+/**
+ * Discrete particle swarm placement over integer VM -> PM positions.
+ * A particle moves by copying each dimension from its personal best, the best of
+ * its island or a random candidate PM with the configured probabilities, and is
+ * then repaired so that no PM exceeds its capacity. Several islands evolve on
+ * separate threads and pass their best particle around a ring every few iterations.
+ * Fitness is the PAPSO objective, evaluated incrementally.
+ */
+class DiscretePSOStrategy : public IPlacementStrategy
+{
+public:
+    DiscretePSOStrategy();
+    ~DiscretePSOStrategy() override;
+
+    Results run(const std::vector<VirtualMachine *> &newRequests, const std::vector<VirtualMachine *> &toMigrate, const std::vector<PhysicalMachine> &machines) override;
+    // The operation budget counts swarm iterations, the islands check the clock and the cancellation every iteration
+    Results runBudgeted(const std::vector<VirtualMachine *> &newRequests, const std::vector<VirtualMachine *> &toMigrate, const std::vector<PhysicalMachine> &machines, const PlacementBudget &budget) override;
+    double getMigrationThreshold() override;
+    size_t getBundleSize() override;
+
+    QWidget *createConfigWidget(QWidget *parent = nullptr) override;
+    void applyConfigFromUI() override;
+    QWidget *createStatusWidget(QWidget *parent = nullptr) override;
+    QString name() const override;
+    IPlacementStrategy *clone() const override;
+
+private:
+    struct Particle
+    {
+        std::vector<int> position; // VM -> candidate index
+        std::vector<int> bestPosition;
+        double bestValue;
+    };
+
+    struct Island
+    {
+        std::mt19937 rng;
+        PAPSOFitness *fitness{nullptr};
+        std::vector<Particle> particles;
+        int best{0}; // index of the particle holding the island best
+    };
+
+    void initializeIsland(Island &island, int numVMs, int numPMs);
+    int evolveIsland(Island &island, int iterations, int numPMs, const BudgetTracker &tracker);
+    void moveParticle(Island &island, size_t index, const std::vector<int> &guide, int numPMs);
+    void repairParticle(Island &island, size_t index, int numPMs);
+    double evaluateParticle(Island &island, size_t index);
+    void migrateBest(std::vector<Island> &islands);
+
+    // Search
+    int m_islandCount{4};
+    int m_particlesPerIsland{15};
+    int m_maxIterations{100};
+    int m_migrationInterval{10}; // iterations between two ring migrations
+    int m_stallEpochs{3};        // migration epochs without global improvement before stopping, 0 disables
+    double m_cognitiveProbability{0.3};
+    double m_socialProbability{0.4};
+    double m_mutationProbability{0.05};
+
+    // Objective and candidates, as in PAPSO
+    double m_w1{0.5}, m_w2{0.5};
+    double m_utilThreshold{0.8};
+    double m_extraMachineCoefficient{1.0};
+    size_t m_bundleSize{10};
+    std::mt19937 m_rng; // seeds the islands, default seeded for reproducible runs
+
+    CandidateSelector m_candidateSelector;
+    std::vector<const PhysicalMachine *> m_candidates; // candidate index -> PM
+    std::vector<int> m_vmOrder;                        // VMs by decreasing CPU demand, for the repair
+
+    // GUI
+    QWidget *m_configWidget{nullptr};
+    QWidget *m_statusWidget{nullptr};
+    QSpinBox *m_islandCountSpin{nullptr};
+    QSpinBox *m_particlesPerIslandSpin{nullptr};
+    QSpinBox *m_maxIterationsSpin{nullptr};
+    QSpinBox *m_migrationIntervalSpin{nullptr};
+    QSpinBox *m_stallEpochsSpin{nullptr};
+    QDoubleSpinBox *m_cognitiveSpin{nullptr};
+    QDoubleSpinBox *m_socialSpin{nullptr};
+    QDoubleSpinBox *m_mutationSpin{nullptr};
+    QDoubleSpinBox *m_w1Spin{nullptr};
+    QDoubleSpinBox *m_w2Spin{nullptr};
+    QDoubleSpinBox *m_utilThresholdSpin{nullptr};
+    QDoubleSpinBox *m_extraMachineCoefficientSpin{nullptr};
+    QSpinBox *m_bundleSizeSpin{nullptr};
+};
\ No newline at end of file
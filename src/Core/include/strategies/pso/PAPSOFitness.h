@@ -0,0 +1,77 @@
+#pragma once
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "data/PhysicalMachine.h"
+#include "data/VirtualMachine.h"
+
+// Inputs of one PSO run, shared read-only by every copy of the objective
+struct PAPSOContext
+{
+    PAPSOContext(const std::vector<VirtualMachine *> &vms, const std::vector<const PhysicalMachine *> &pms, double w1, double w2, double utilThreshold);
+
+    bool isActive(const Resources &load) const { return load.cpu > 0.0; }
+    bool isOverloaded(int pm, const Resources &load) const
+    {
+        Resources utilization = load / totals[pm];
+        return utilization.cpu > utilThreshold || utilization.ram > utilThreshold || utilization.disk > utilThreshold || utilization.bandwidth > utilThreshold || utilization.fpga > utilThreshold;
+    }
+
+    std::vector<Resources> demands;   // per VM
+    std::vector<Resources> baseLoads; // per PM, before the bundle
+    std::vector<Resources> totals;    // per PM
+    int baseActiveCount{0};
+    int baseOverloadedCount{0};
+    double w1, w2;
+    double utilThreshold;
+};
+
+/**
+ * Fitness of PAPSO particles, evaluated incrementally.
+ * Each particle keeps the loads of the PMs its assignment touches and the active and
+ * overloaded PM counts. Moving a VM only re-examines its old and new PM, so an evaluation
+ * costs O(changed dimensions) instead of O(VMs + PMs).
+ */
+class PAPSOFitness
+{
+public:
+    explicit PAPSOFitness(std::shared_ptr<const PAPSOContext> context) : m_context(std::move(context)) {}
+
+    // Drops the state of every particle, they start with no VM assigned
+    void resetParticles(size_t count);
+
+    // Moves VM vm of the particle to PM pm
+    void assign(size_t particle, int vm, int pm);
+    int getAssignment(size_t particle, int vm) const { return m_particles[particle].assignment[vm]; }
+    // Load of PM pm under the particle's assignment
+    Resources getLoad(size_t particle, int pm) const;
+
+    double score(size_t particle) const;
+
+    // From scratch, for assignments without a particle state
+    double evaluate(const std::vector<int> &assignment) const;
+
+    const PAPSOContext &getContext() const { return *m_context; }
+
+private:
+    struct TouchedPM
+    {
+        Resources load;
+        int vmCount{0};
+    };
+
+    struct ParticleState
+    {
+        std::vector<int> assignment;                // -1 until the VM is first assigned
+        std::unordered_map<int, TouchedPM> touched; // loads that differ from the baseline
+        int activeCount{0};
+        int overloadedCount{0};
+    };
+
+    void change(ParticleState &state, int pm, const Resources &demand, int direction) const;
+    double score(int activeCount, int overloadedCount) const;
+
+    std::shared_ptr<const PAPSOContext> m_context;
+    std::vector<ParticleState> m_particles;
+};
@@ -1,11 +1,16 @@
 #pragma once
 
 #include "../IPlacementStrategy.h"
+#include "../CandidateSelector.h"
 #include <vector>
 #include <random>
 #include <limits>
 #include <algorithm>
 #include <Eigen/Dense>
+#include <QCheckBox>
+#include <unordered_map>
+
+struct PAPSOContext;
 
 class PAPSOStrategy : public IPlacementStrategy
 {
@@ -19,6 +24,10 @@ public:
     virtual Results run(const std::vector<VirtualMachine *> &newRequests,
                         const std::vector<VirtualMachine *> &toMigrate,
                         const std::vector<PhysicalMachine> &machines) override;
+    Results runBudgeted(const std::vector<VirtualMachine *> &newRequests,
+                        const std::vector<VirtualMachine *> &toMigrate,
+                        const std::vector<PhysicalMachine> &machines,
+                        const PlacementBudget &budget) override;
 
     double getMigrationThreshold() override;
     size_t getBundleSize() override;
@@ -27,8 +36,18 @@ public:
     void applyConfigFromUI() override;
     QWidget *createStatusWidget(QWidget *parent = nullptr) override;
     QString name() const override;
+    IPlacementStrategy *clone() const override;
 
 private:
+    // Fills m_candidates with the PMs the swarm searches over
+    void chooseCandidates(const std::vector<VirtualMachine *> &vms, const std::vector<PhysicalMachine> &machines);
+
+    // Warm start: heuristic and previous solutions, and a swarm scattered around them
+    std::vector<std::vector<int>> buildSeeds(const PAPSOContext &context, const std::vector<VirtualMachine *> &vms) const;
+    std::vector<int> greedySeed(const PAPSOContext &context, bool bestFit) const;
+    Eigen::MatrixXd initializeSwarm(const std::vector<std::vector<int>> &seeds, int numPMs);
+    void rememberBest(const std::vector<VirtualMachine *> &vms, const std::vector<int> &pmIds);
+
     // Internal representation of a PSO particle
     struct Particle
     {
@@ -46,6 +65,21 @@ private:
     double m_maxVelocity;
 
     double m_utilThreshold{0.8};
+    int m_threads{0}; // swarm evaluation threads, 0 for every core
+
+    // Candidate set: turned on PMs plus the cheapest turned off PMs that fit the bundle
+    bool m_useCandidateSet{true};
+    double m_extraMachineCoefficient{1.0};
+    CandidateSelector m_candidateSelector;
+    std::vector<const PhysicalMachine *> m_candidates; // swarm index -> PM
+
+    // Warm start and early stop
+    bool m_warmStart{true};
+    double m_seedPerturbation{0.2}; // share of the dimensions resampled around a seed
+    int m_stallIterations{15};      // iterations without gbest improvement before stopping, 0 disables
+
+    std::vector<int> m_previousBest;                 // PM ids of the previous gbest, by bundle position
+    std::unordered_map<int, int> m_previousBestByVM; // VM id -> PM id of the previous gbest
 
     std::mt19937 m_rng;
     std::uniform_real_distribution<double> m_uniDist;
@@ -68,4 +102,9 @@ private:
     QDoubleSpinBox *m_c2Spin{nullptr};
     QDoubleSpinBox *m_utilThresholdSpin{nullptr};
     QDoubleSpinBox *m_maxVelocitySpin{nullptr};
+    QSpinBox *m_threadsSpin{nullptr};
+    QCheckBox *m_useCandidateSetCheck{nullptr};
+    QDoubleSpinBox *m_extraMachineCoefficientSpin{nullptr};
+    QCheckBox *m_warmStartCheck{nullptr};
+    QSpinBox *m_stallIterationsSpin{nullptr};
 };
\ No newline at end of file
@@ -3,9 +3,11 @@
 #include "strategies/FirstFitDecreasing.h"
 #include "strategies/BestFitDecreasing.h"
 #include <algorithm>
+#include <chrono>
 #include <iostream>
+#if defined(CDC_WITH_CPLEX) && defined(CDC_WITH_TORCH)
 #include "strategies/drl/ILPDQNStrategy.h"
-#include "strategies/pso/PAPSOStrategy.h"
+#endif
 
 DataCenter::DataCenter()
     : m_strategy(nullptr)
@@ -16,6 +18,25 @@ DataCenter::DataCenter()
 
 DataCenter::~DataCenter()
 {
+    // An asynchronous placement may still be running on its worker, ask it to stop with its incumbent
+    if (m_inFlight.decisions.valid())
+    {
+        m_placementCancel = true;
+        m_inFlight.decisions.wait();
+    }
+    if (m_inFlight.strategy && m_inFlight.strategy != m_strategy)
+    {
+        delete m_inFlight.strategy;
+    }
+    for (auto *vm : m_inFlight.newRequests)
+    {
+        delete vm;
+    }
+    for (auto *vm : m_inFlight.vmClones)
+    {
+        delete vm;
+    }
+
     // Clean up strategy
     if (m_strategy)
     {
@@ -42,10 +63,29 @@ void DataCenter::setPlacementStrategy(IPlacementStrategy *strat)
 {
     std::lock_guard<std::mutex> lock(m_strategyMutex);
 
-    if (m_strategy)
+    // A strategy still solving asynchronously is deleted once its decisions are committed
+    if (m_strategy && m_strategy != m_inFlight.strategy)
         delete m_strategy;
 
     m_strategy = strat;
+
+    // The cached decisions were taken by the previous strategy, the clusters copied its settings
+    m_placementCache.clear();
+    m_partitioner.invalidateStrategies();
+}
+
+void DataCenter::setPlacementClustering(size_t clusterSize, const std::string &strategyName)
+{
+    m_partitioner.setStrategyName(strategyName);
+    m_partitioner.setClusterSize(clusterSize);
+
+    // The cached decisions were taken by another strategy or over the whole fleet
+    m_placementCache.clear();
+
+    if (clusterSize > 0)
+        LogManager::instance().log(LogCategory::PLACEMENT, "Clustered placement with " + (strategyName.empty() ? std::string("the placement strategy") : strategyName) + " on clusters of " + std::to_string(clusterSize) + " PMs");
+    else
+        LogManager::instance().log(LogCategory::PLACEMENT, "Clustered placement turned off");
 }
 
 IPlacementStrategy *DataCenter::getPlacementStrategy() const
@@ -54,30 +94,232 @@ IPlacementStrategy *DataCenter::getPlacementStrategy() const
     return m_strategy;
 }
 
+void DataCenter::setMigrationSelectionPolicy(MigrationSelectionPolicy policy)
+{
+    std::lock_guard<std::mutex> lock(m_bundleMutex);
+    m_migrationCandidates.setPolicy(policy);
+}
+
+MigrationSelectionPolicy DataCenter::getMigrationSelectionPolicy() const
+{
+    std::lock_guard<std::mutex> lock(m_bundleMutex);
+    return m_migrationCandidates.getPolicy();
+}
+
+void DataCenter::setMaxBundleWait(double seconds)
+{
+    std::lock_guard<std::mutex> lock(m_bundleMutex);
+    m_scheduler.setMaxWait(seconds);
+}
+
+double DataCenter::getMaxBundleWait() const
+{
+    std::lock_guard<std::mutex> lock(m_bundleMutex);
+    return m_scheduler.getMaxWait();
+}
+
+void DataCenter::setBundleSizingMode(BundleSizingMode mode)
+{
+    std::lock_guard<std::mutex> lock(m_bundleMutex);
+    m_scheduler.setSizingMode(mode);
+}
+
+BundleSizingMode DataCenter::getBundleSizingMode() const
+{
+    std::lock_guard<std::mutex> lock(m_bundleMutex);
+    return m_scheduler.getSizingMode();
+}
+
+void DataCenter::setAdaptiveBundleLimits(size_t minSize, size_t maxSize)
+{
+    std::lock_guard<std::mutex> lock(m_bundleMutex);
+    m_scheduler.setBundleSizeLimits(minSize, maxSize);
+}
+
+size_t DataCenter::getAdaptiveBundleMinSize() const
+{
+    std::lock_guard<std::mutex> lock(m_bundleMutex);
+    return m_scheduler.getMinBundleSize();
+}
+
+size_t DataCenter::getAdaptiveBundleMaxSize() const
+{
+    std::lock_guard<std::mutex> lock(m_bundleMutex);
+    return m_scheduler.getMaxBundleSize();
+}
+
+void DataCenter::setTargetSolveTime(double seconds)
+{
+    std::lock_guard<std::mutex> lock(m_bundleMutex);
+    m_scheduler.setTargetSolveTime(seconds);
+}
+
+double DataCenter::getTargetSolveTime() const
+{
+    std::lock_guard<std::mutex> lock(m_bundleMutex);
+    return m_scheduler.getTargetSolveTime();
+}
+
+double DataCenter::getAveragePlacementDelay() const
+{
+    return m_scheduler.getAveragePlacementDelay();
+}
+
+double DataCenter::getMaxPlacementDelay() const
+{
+    return m_scheduler.getMaxPlacementDelay();
+}
+
+double DataCenter::getArrivalRate() const
+{
+    return m_scheduler.getArrivalRate();
+}
+
+double DataCenter::getLastSolveTime() const
+{
+    return m_scheduler.getLastSolveTime();
+}
+
+void DataCenter::beginBatch()
+{
+    m_inBatch = true;
+    m_batchPlacementRequested = false;
+    m_batchCommitRequested = false;
+    m_batchConsolidationRequested = false;
+    m_batchedUpdates.clear();
+}
+
+void DataCenter::endBatch(SimulationEngine &engine)
+{
+    m_inBatch = false;
+
+    applyBatchedUpdates(engine);
+
+    // Validate asynchronous decisions against the state after the batch
+    if (m_batchCommitRequested)
+    {
+        m_batchCommitRequested = false;
+        std::lock_guard<std::mutex> lock(m_bundleMutex);
+        commitPlacement(engine);
+    }
+
+    // At most one placement for the whole batch
+    if (m_batchPlacementRequested)
+    {
+        m_batchPlacementRequested = false;
+        std::lock_guard<std::mutex> lock(m_bundleMutex);
+        runPlacement(engine);
+    }
+
+    if (m_batchConsolidationRequested)
+    {
+        m_batchConsolidationRequested = false;
+        std::lock_guard<std::mutex> lock(m_bundleMutex);
+        runConsolidation(engine);
+    }
+}
+
+void DataCenter::applyBatchedUpdates(SimulationEngine &engine)
+{
+    if (m_batchedUpdates.empty())
+        return;
+
+    // Group the usage changes by PM so that every PM is mutated once
+    std::map<int, std::vector<std::pair<Resources, Resources>>> changes; // pmId -> (old usage, new usage)
+    {
+        std::lock_guard<std::mutex> lock(m_vmIndexMutex);
+        for (auto &[vmId, utilization] : m_batchedUpdates)
+        {
+            auto it = m_vmIndex.find(vmId);
+            if (it == m_vmIndex.end())
+            {
+                // Departed earlier in the same batch
+                LogManager::instance().log(LogCategory::VM_UTIL_UPDATE, "VM " + std::to_string(vmId) + " departed before its utilization update");
+                continue;
+            }
+            int pmId = it->second.first;
+            VirtualMachine *vmPtr = it->second.second;
+
+            Resources oldUsage = vmPtr->getUsage();
+            vmPtr->setUtilization(utilization);
+            changes[pmId].emplace_back(oldUsage, vmPtr->getUsage());
+
+            if (vmPtr->isMigrating())
+            {
+                // The old PM still holds the VM until the migration completes
+                changes[vmPtr->getOldPMID()].emplace_back(oldUsage, vmPtr->getUsage());
+            }
+        }
+    }
+    m_batchedUpdates.clear();
+
+    for (auto &[pmId, pmChanges] : changes)
+    {
+        mutateMachine(m_physicalMachines[pmId], [&pmChanges](PhysicalMachine &machine)
+                      {
+            for (auto &[oldUsage, newUsage] : pmChanges)
+            {
+                machine.free(oldUsage);
+                machine.allocate(newUsage);
+            } });
+        LogManager::instance().log(LogCategory::VM_UTIL_UPDATE, "PM " + std::to_string(pmId) + " updated " + std::to_string(pmChanges.size()) + " VMs - available: " + std::to_string(m_physicalMachines[pmId].getTotal().cpu - m_physicalMachines[pmId].getUsed().cpu));
+    }
+
+    // One threshold check per touched PM
+    for (auto &change : changes)
+    {
+        if (detectOvercommitment(change.first, engine))
+        {
+            m_batchPlacementRequested = true;
+        }
+    }
+}
+
 void DataCenter::addPhysicalMachine(const PhysicalMachine &pm)
 {
     m_physicalMachines.push_back(pm);
+    m_fleetStatistics.add(m_physicalMachines.back());
 }
 
 void DataCenter::handle(const VMRequestEvent &event, SimulationEngine &engine)
 {
     auto vm = const_cast<VMRequestEvent &>(event).takeVM();
     VirtualMachine *rawVm = vm.release();
+    rawVm->setRequestTime(event.getTime());
+    scheduleConsolidation(engine, event.getTime());
 
     // push to pending
     {
         std::lock_guard<std::mutex> lock(m_bundleMutex);
         m_NewRequestCountSinceLastPlacement++;
+        m_scheduler.onRequestArrival(event.getTime());
+
+        // The first request of a bundle bounds how long the bundle may wait
+        if (m_scheduler.needsFlush(m_pendingNewRequests.size()))
+        {
+            engine.pushEvent(std::make_shared<PlacementFlushEvent>(event.getTime() + m_scheduler.getMaxWait(), m_scheduler.getGeneration()));
+        }
+
         m_pendingNewRequests.push_back(rawVm);
         if (m_pendingNewRequests.size() >= getBundleSize())
         {
-            runPlacement(engine);
+            if (m_inBatch)
+                m_batchPlacementRequested = true;
+            else
+                runPlacement(engine);
         }
     }
 }
 
 void DataCenter::handle(const VMUtilUpdateEvent &event, SimulationEngine &engine)
 {
+    if (m_inBatch)
+    {
+        // Applied per PM at the end of the batch
+        m_batchedUpdates[event.getVmId()] = event.getUtilization();
+        return;
+    }
+
     updateVM(event.getVmId(), event.getUtilization());
 
     if (detectOvercommitment(m_vmIndex[event.getVmId()].first, engine))
@@ -96,13 +338,17 @@ void DataCenter::handle(const VMDepartureEvent &event, SimulationEngine &engine)
         int oldPmId = vm->getOldPMID();
         auto &oldPM = m_physicalMachines[oldPmId];
         oldPM.endMigration();
-        oldPM.removeVM(event.getVmId());
+        mutateMachine(oldPM, [&](PhysicalMachine &machine)
+                      { machine.removeVM(event.getVmId()); });
         auto &newPM = m_physicalMachines[m_vmIndex[event.getVmId()].first];
         newPM.endMigration();
 
         LogManager::instance().log(LogCategory::VM_MIGRATION, "VM " + std::to_string(event.getVmId()) + " migration cancelled");
     }
 
+    // Do not hand a departed VM to the next placement
+    m_migrationCandidates.remove(event.getVmId());
+
     removeVM(event.getVmId());
 
     LogManager::instance().log(LogCategory::VM_DEPARTURE, "VM " + std::to_string(event.getVmId()) + " departed");
@@ -125,7 +371,8 @@ void DataCenter::handle(const MigrationCompleteEvent &event, SimulationEngine &e
 
     auto &oldPM = m_physicalMachines[oldPmId];
     oldPM.endMigration();
-    oldPM.removeVM(vmId);
+    mutateMachine(oldPM, [vmId](PhysicalMachine &machine)
+                  { machine.removeVM(vmId); });
 
     // End the migrations in both old and new PMs
     auto &newPM = m_physicalMachines[event.getNewPmId()];
@@ -136,29 +383,359 @@ void DataCenter::handle(const MigrationCompleteEvent &event, SimulationEngine &e
     LogManager::instance().log(LogCategory::VM_MIGRATION, "VM " + std::to_string(vmId) + " migrated from PM " + std::to_string(oldPmId) + " to PM " + std::to_string(event.getNewPmId()));
 }
 
+void DataCenter::handle(const PlacementFlushEvent &event, SimulationEngine &engine)
+{
+    std::lock_guard<std::mutex> lock(m_bundleMutex);
+
+    // The bundle this flush was scheduled for has been placed already
+    if (event.getGeneration() != m_scheduler.getGeneration() || m_pendingNewRequests.empty())
+        return;
+
+    LogManager::instance().log(LogCategory::PLACEMENT, "Flushing " + std::to_string(m_pendingNewRequests.size()) + " pending requests after the maximum wait");
+    if (m_inBatch)
+        m_batchPlacementRequested = true;
+    else
+        runPlacement(engine);
+}
+
 void DataCenter::runPlacement(SimulationEngine &engine)
 {
     if (!m_strategy)
         return;
 
+    // The next bundle waits for the decisions in flight
+    if (m_inFlight.active)
+        return;
+
     Results decisions;
 
     std::lock_guard<std::mutex> lock(m_strategyMutex);
 
-    if (auto ilpdqn = dynamic_cast<ILPDQNStrategy *>(m_strategy))
+    // The DQN agent observes the live data center around its run, so it always solves in place
+    bool solveInPlace = false;
+#if defined(CDC_WITH_CPLEX) && defined(CDC_WITH_TORCH)
+    auto ilpdqn = dynamic_cast<ILPDQNStrategy *>(m_strategy);
+    if (ilpdqn)
     {
         ilpdqn->setDataCenter(this);
+        solveInPlace = true;
+    }
+#endif
+
+    if (m_asyncPlacement && !solveInPlace)
+    {
+        launchPlacement(engine);
+        return;
     }
 
-    decisions = m_strategy->run(m_pendingNewRequests, m_pendingMigrations, m_physicalMachines);
+    std::string solvedBy;
+    auto solveStart = std::chrono::steady_clock::now();
+    decisions = solvePlacement(m_strategy, m_pendingNewRequests, m_migrationCandidates.getCandidates(), m_physicalMachines, placementBudget(), solveInPlace, solvedBy);
+    double solveSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - solveStart).count();
+    recordPlacementQuality(decisions.quality);
+    m_scheduler.onPlacement(m_pendingNewRequests.size() + m_migrationCandidates.size(), solveSeconds);
 
     m_pendingNewRequests.clear();
-    m_pendingMigrations.clear();
+    m_migrationCandidates.clear();
 
     m_SLAVcountSinceLastPlacement = 0;
     m_MigrationCountSinceLastPlacement = 0;
     m_NewRequestCountSinceLastPlacement = 0;
 
+    commitDecisions(decisions, solvedBy, engine);
+
+#if defined(CDC_WITH_CPLEX) && defined(CDC_WITH_TORCH)
+    if (ilpdqn)
+    {
+        ilpdqn->updateAgent();
+    }
+#endif
+}
+
+void DataCenter::launchPlacement(SimulationEngine &engine)
+{
+    // The worker owns the bundle and sees copies only, the engine keeps mutating the live state
+    m_inFlight.active = true;
+    m_inFlight.strategy = m_strategy;
+    m_inFlight.newRequests.swap(m_pendingNewRequests);
+
+    // The snapshot PMs point to copies of their VMs, the decisions are mapped back by VM id
+    std::unordered_map<int, VirtualMachine *> clones;
+    m_inFlight.machines = m_physicalMachines;
+    for (auto &pm : m_inFlight.machines)
+    {
+        std::vector<VirtualMachine *> copies;
+        copies.reserve(pm.getVirtualMachines().size());
+        for (auto *vm : pm.getVirtualMachines())
+        {
+            auto *copy = new VirtualMachine(*vm);
+            copies.push_back(copy);
+            clones[vm->getID()] = copy;
+            m_inFlight.vmClones.push_back(copy);
+        }
+        pm.rebindVMs(copies);
+    }
+    for (auto *vm : m_migrationCandidates.getCandidates())
+    {
+        auto clone = clones.find(vm->getID());
+        if (clone != clones.end())
+        {
+            m_inFlight.migrationClones.push_back(clone->second);
+            continue;
+        }
+        auto *copy = new VirtualMachine(*vm);
+        m_inFlight.migrationClones.push_back(copy);
+        m_inFlight.vmClones.push_back(copy);
+    }
+
+    m_migrationCandidates.clear();
+
+    m_SLAVcountSinceLastPlacement = 0;
+    m_MigrationCountSinceLastPlacement = 0;
+    m_NewRequestCountSinceLastPlacement = 0;
+
+    IPlacementStrategy *strategy = m_strategy;
+    PlacementBudget budget = placementBudget();
+    m_inFlight.decisions = std::async(std::launch::async, [this, strategy, budget]()
+                                      {
+        auto solveStart = std::chrono::steady_clock::now();
+        Results results = solvePlacement(strategy, m_inFlight.newRequests, m_inFlight.migrationClones, m_inFlight.machines, budget, false, m_inFlight.solvedBy);
+        m_inFlight.solveSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - solveStart).count();
+        return results; });
+
+    double readyTime = engine.currentTime() + m_decisionLatency;
+    engine.pushEvent(std::make_shared<PlacementReadyEvent>(readyTime));
+
+    LogManager::instance().log(LogCategory::PLACEMENT, "Solving " + std::to_string(m_inFlight.newRequests.size()) + " requests and " + std::to_string(m_inFlight.migrationClones.size()) + " migrations asynchronously, decisions due at " + std::to_string(readyTime));
+}
+
+void DataCenter::handle(const PlacementReadyEvent &event, SimulationEngine &engine)
+{
+    if (m_inBatch)
+    {
+        // Committed after the utilization updates of the batch
+        m_batchCommitRequested = true;
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_bundleMutex);
+    commitPlacement(engine);
+}
+
+Results DataCenter::solvePlacement(IPlacementStrategy *strategy, const std::vector<VirtualMachine *> &newRequests, const std::vector<VirtualMachine *> &toMigrate, const std::vector<PhysicalMachine> &machines, const PlacementBudget &budget, bool solveInPlace, std::string &solvedBy)
+{
+    bool useCache = !solveInPlace && m_placementCacheEnabled;
+
+    Results results;
+    BudgetTracker tracker(budget);
+    if (useCache && m_placementCache.lookup(newRequests, toMigrate, machines, results))
+    {
+        results.quality.iterations = 0;
+        results.quality.seconds = tracker.elapsed();
+        solvedBy = "the placement cache";
+        LogManager::instance().log(LogCategory::PLACEMENT, "Reused the cached decisions of an identical bundle");
+        return results;
+    }
+
+    // A strategy solving in place needs the whole data center
+    if (!solveInPlace && m_partitioner.appliesTo(machines))
+    {
+        std::string clusterStrategy = m_partitioner.getStrategyName();
+        solvedBy = (clusterStrategy.empty() ? strategy->name().toStdString() : clusterStrategy) + " per cluster";
+        results = m_partitioner.solve(newRequests, toMigrate, machines, budget, strategy);
+    }
+    else
+    {
+        solvedBy = strategy->name().toStdString();
+        results = strategy->runBudgeted(newRequests, toMigrate, machines, budget);
+    }
+
+    // An incumbent cut short by the budget is not worth replaying
+    if (useCache && results.quality.complete)
+        m_placementCache.store(newRequests, toMigrate, machines, results);
+
+    return results;
+}
+
+void DataCenter::handle(const ConsolidationEvent &event, SimulationEngine &engine)
+{
+    m_consolidationScheduled = false;
+    if (m_inBatch)
+    {
+        // Runs on the state after the batch
+        m_batchConsolidationRequested = true;
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_bundleMutex);
+    runConsolidation(engine);
+}
+
+void DataCenter::scheduleConsolidation(SimulationEngine &engine, double now)
+{
+    // Scheduled from the arrivals, so the passes stop with the trace
+    if (m_consolidationInterval <= 0 || m_consolidationScheduled)
+        return;
+
+    engine.pushEvent(std::make_shared<ConsolidationEvent>(now + m_consolidationInterval));
+    m_consolidationScheduled = true;
+}
+
+void DataCenter::runConsolidation(SimulationEngine &engine)
+{
+    if (m_consolidationInterval <= 0)
+        return;
+
+    // The decisions in flight were taken on a snapshot the migrations would invalidate
+    if (m_inFlight.active)
+    {
+        LogManager::instance().log(LogCategory::VM_MIGRATION, "Consolidation skipped, a placement is in flight");
+        return;
+    }
+
+    PlacementBudget budget;
+    budget.wallSeconds = m_consolidationBudget;
+    budget.cancel = &m_placementCancel;
+    Results decisions = m_consolidator.runBudgeted({}, {}, m_physicalMachines, budget);
+
+    LogManager::instance().log(LogCategory::VM_MIGRATION, "Consolidation migrates " + std::to_string(decisions.migrationDecision.size()) + " VMs, cost " + std::to_string(decisions.quality.objective) + " after " + std::to_string(decisions.quality.iterations) + " iterations in " + std::to_string(decisions.quality.seconds) + " s");
+    m_consolidationMigrations += commitDecisions(decisions, m_consolidator.name().toStdString(), engine);
+}
+
+PlacementBudget DataCenter::placementBudget() const
+{
+    PlacementBudget budget;
+    budget.wallSeconds = m_placementDeadline;
+    budget.cancel = &m_placementCancel;
+    return budget;
+}
+
+void DataCenter::recordPlacementQuality(const PlacementQuality &quality)
+{
+    if (!quality.complete)
+        m_incompletePlacements++;
+
+    // Strategies check the budget between units of work, so a run may overshoot by one unit
+    double deadline = m_placementDeadline;
+    if (deadline > 0 && quality.seconds > deadline)
+    {
+        m_placementDeadlineMisses++;
+        LogManager::instance().log(LogCategory::WARNING, "Placement took " + std::to_string(quality.seconds) + " s, over the " + std::to_string(deadline) + " s deadline");
+    }
+
+    LogManager::instance().log(LogCategory::PLACEMENT, "Placement quality: objective " + std::to_string(quality.objective) + ", gap " + std::to_string(quality.gap) + ", " + std::to_string(quality.iterations) + " iterations in " + std::to_string(quality.seconds) + " s" + (quality.complete ? "" : ", cut short by the budget"));
+}
+
+void DataCenter::commitPlacement(SimulationEngine &engine)
+{
+    if (!m_inFlight.active)
+        return;
+
+    // Blocks when the solver is slower than the simulated decision latency
+    Results decisions = m_inFlight.decisions.get();
+    m_scheduler.onPlacement(m_inFlight.newRequests.size() + m_inFlight.migrationClones.size(), m_inFlight.solveSeconds);
+    recordPlacementQuality(decisions.quality);
+
+    std::vector<int> staleSources = validateDecisions(decisions);
+    commitDecisions(decisions, m_inFlight.solvedBy, engine);
+
+    for (auto *vm : m_inFlight.vmClones)
+    {
+        delete vm;
+    }
+    m_inFlight.vmClones.clear();
+    m_inFlight.migrationClones.clear();
+    m_inFlight.newRequests.clear();
+    m_inFlight.machines.clear();
+    m_inFlight.active = false;
+    {
+        std::lock_guard<std::mutex> lock(m_strategyMutex);
+        if (m_inFlight.strategy != m_strategy)
+        {
+            delete m_inFlight.strategy;
+        }
+        m_inFlight.strategy = nullptr;
+    }
+
+    // Overcommitted PMs whose migrations were dropped queue their VMs again
+    for (int pmId : staleSources)
+    {
+        detectOvercommitment(pmId, engine);
+    }
+
+    schedulePendingPlacement(engine);
+}
+
+std::vector<int> DataCenter::validateDecisions(Results &decisions)
+{
+    // Load the decisions add to each PM, so that they are checked together
+    std::unordered_map<int, Resources> added;
+    auto fits = [&](int pmId, const Resources &usage)
+    {
+        Resources &load = added[pmId];
+        if (!m_physicalMachines[pmId].canHost(load + usage))
+            return false;
+        load += usage;
+        return true;
+    };
+
+    // Requests whose PM no longer fits them go back to the front of the queue
+    std::vector<VirtualMachine *> requeued;
+    std::vector<PlacementDecision> placements;
+    placements.reserve(decisions.placementDecision.size());
+    for (auto &pd : decisions.placementDecision)
+    {
+        if (pd.pmId >= 0 && !fits(pd.pmId, pd.vm->getUsage()))
+        {
+            requeued.push_back(pd.vm);
+            continue;
+        }
+        placements.push_back(pd);
+    }
+    decisions.placementDecision.swap(placements);
+
+    if (!requeued.empty())
+    {
+        LogManager::instance().log(LogCategory::PLACEMENT, "Re-queued " + std::to_string(requeued.size()) + " requests whose PM filled up during the solve");
+        m_pendingNewRequests.insert(m_pendingNewRequests.begin(), requeued.begin(), requeued.end());
+    }
+
+    // Migrations were decided on copies, map them back to the live VMs that are still where they were
+    std::vector<int> staleSources;
+    std::vector<PlacementDecision> migrations;
+    migrations.reserve(decisions.migrationDecision.size());
+    std::lock_guard<std::mutex> lock(m_vmIndexMutex);
+    for (auto &pd : decisions.migrationDecision)
+    {
+        auto it = m_vmIndex.find(pd.vm->getID());
+        if (it == m_vmIndex.end())
+            continue; // departed during the solve
+
+        VirtualMachine *vm = it->second.second;
+        if (vm->isMigrating() || it->second.first != pd.vm->getPMID())
+            continue; // moved during the solve
+
+        if (pd.pmId >= 0 && pd.pmId != it->second.first && !fits(pd.pmId, vm->getUsage()))
+        {
+            staleSources.push_back(it->second.first);
+            continue;
+        }
+        migrations.push_back({vm, pd.pmId});
+    }
+    decisions.migrationDecision.swap(migrations);
+
+    return staleSources;
+}
+
+size_t DataCenter::commitDecisions(Results &decisions, const std::string &solvedBy, SimulationEngine &engine)
+{
+    // Move infeasible decisions to feasible PMs before committing any of them
+    size_t repaired = m_repair.repair(decisions, m_physicalMachines);
+    if (repaired > 0)
+    {
+        LogManager::instance().log(LogCategory::WARNING, "Repaired " + std::to_string(repaired) + " infeasible decisions of " + solvedBy);
+    }
+
     // Handle new requests
     for (auto &pd : decisions.placementDecision)
     {
@@ -169,13 +746,16 @@ void DataCenter::runPlacement(SimulationEngine &engine)
         }
         else
         {
-            LogManager::instance().log(LogCategory::PLACEMENT, "VM " + std::to_string(pd.vm->getID()) + " placed on PM " + std::to_string(pd.pmId));
+            double delay = engine.currentTime() - pd.vm->getRequestTime();
+            LogManager::instance().log(LogCategory::PLACEMENT, "VM " + std::to_string(pd.vm->getID()) + " placed on PM " + std::to_string(pd.pmId) + " after waiting " + std::to_string(delay) + " s");
             placeVMonPM(pd.vm, pd.pmId, engine);
+            m_scheduler.onVMPlaced(delay);
         }
     }
 
     // Handle migrations
     unsigned int numberOfMigrations = decisions.migrationDecision.size();
+    size_t scheduled = 0;
     for (auto &pd : decisions.migrationDecision)
     {
         if (pd.pmId < 0)
@@ -191,12 +771,39 @@ void DataCenter::runPlacement(SimulationEngine &engine)
         {
             LogManager::instance().log(LogCategory::VM_MIGRATION, "VM " + std::to_string(pd.vm->getID()) + " migrating from PM " + std::to_string(m_vmIndex[pd.vm->getID()].first) + " to PM " + std::to_string(pd.pmId));
             scheduleMigration(engine, pd.vm->getID(), pd.pmId, numberOfMigrations);
+            scheduled++;
+
+            // Overcommitment detected during an async solve may have queued the VM again
+            m_migrationCandidates.remove(pd.vm->getID());
         }
     }
+    return scheduled;
+}
+
+void DataCenter::schedulePendingPlacement(SimulationEngine &engine)
+{
+    if (m_pendingNewRequests.empty() && m_migrationCandidates.size() == 0)
+        return;
 
-    if (auto ilpdqn = dynamic_cast<ILPDQNStrategy *>(m_strategy))
+    // Requests that arrived during the solve already passed their flush, place them now if due
+    double oldestRequest = engine.currentTime();
+    for (auto *vm : m_pendingNewRequests)
     {
-        ilpdqn->updateAgent();
+        oldestRequest = std::min(oldestRequest, vm->getRequestTime());
+    }
+    double maxWait = m_scheduler.getMaxWait();
+    bool due = m_pendingNewRequests.size() >= getBundleSize() || m_migrationCandidates.size() > 0 || (maxWait > 0 && engine.currentTime() - oldestRequest >= maxWait);
+
+    if (due)
+    {
+        if (m_inBatch)
+            m_batchPlacementRequested = true;
+        else
+            runPlacement(engine);
+    }
+    else if (maxWait > 0)
+    {
+        engine.pushEvent(std::make_shared<PlacementFlushEvent>(oldestRequest + maxWait, m_scheduler.getGeneration()));
     }
 }
 
@@ -218,7 +825,8 @@ void DataCenter::scheduleMigration(SimulationEngine &engine, int vmID, int new_p
     vm->setMigrating(true);
 
     auto &newPM = m_physicalMachines[new_pmID];
-    newPM.addVM(vm);
+    mutateMachine(newPM, [vm](PhysicalMachine &machine)
+                  { machine.addVM(vm); });
     // update index
     {
         std::lock_guard<std::mutex> lock(m_vmIndexMutex);
@@ -258,18 +866,9 @@ bool DataCenter::detectOvercommitment(int pmId, SimulationEngine &engine)
             m_SLAVcountSinceLastPlacement++;
         }
 
-        const std::vector<VirtualMachine *> &vmsOnPM = m_physicalMachines[pmId].getVirtualMachines();
-
-        // We do a while loop if we want
-        for (auto *vm : vmsOnPM)
-        {
-            if (vm->isMigrating())
-            {
-                continue; // skip already in migration
-            }
-
-            m_pendingMigrations.push_back(vm);
-        }
+        // Queue only the VMs needed to bring the PM back under the threshold, each VM at most once
+        size_t queued = m_migrationCandidates.addFromMachine(m_physicalMachines[pmId], MSThreshold);
+        LogManager::instance().log(LogCategory::VM_MIGRATION, "PM " + std::to_string(pmId) + " overcommitted, queued " + std::to_string(queued) + " VMs for migration");
 
         return true;
     }
@@ -298,18 +897,21 @@ bool DataCenter::updateVM(int vmId, double utilization)
     vmPtr->setUtilization(utilization);
 
     PhysicalMachine &pm = m_physicalMachines[pmId];
-    pm.free(oldUsage);
-    LogManager::instance().log(LogCategory::VM_UTIL_UPDATE, "VM " + std::to_string(vmId) + " updated on PM " + std::to_string(pmId) + " - new usage: " + std::to_string(vmPtr->getUsage().cpu) + " - available: " + std::to_string(pm.getTotal().cpu - pm.getUsed().cpu));
-    pm.allocate(vmPtr->getUsage());
+    mutateMachine(pm, [&](PhysicalMachine &machine)
+                  {
+        machine.free(oldUsage);
+        LogManager::instance().log(LogCategory::VM_UTIL_UPDATE, "VM " + std::to_string(vmId) + " updated on PM " + std::to_string(pmId) + " - new usage: " + std::to_string(vmPtr->getUsage().cpu) + " - available: " + std::to_string(machine.getTotal().cpu - machine.getUsed().cpu));
+        machine.allocate(vmPtr->getUsage()); });
 
     if (vmPtr->isMigrating())
     {
         // migration is in progress
         // we need to update the old PM as well
         int oldPMID = vmPtr->getOldPMID();
-        PhysicalMachine &oldPM = m_physicalMachines[oldPMID];
-        oldPM.free(oldUsage);
-        oldPM.allocate(vmPtr->getUsage());
+        mutateMachine(m_physicalMachines[oldPMID], [&](PhysicalMachine &oldPM)
+                      {
+            oldPM.free(oldUsage);
+            oldPM.allocate(vmPtr->getUsage()); });
     }
 
     return true;
@@ -326,10 +928,11 @@ bool DataCenter::removeVM(int vmId)
     int pmId = it->second.first;
     VirtualMachine *vmPtr = it->second.second;
 
-    PhysicalMachine &pm = m_physicalMachines[pmId];
-    pm.removeVM(vmId);
+    mutateMachine(m_physicalMachines[pmId], [vmId](PhysicalMachine &machine)
+                  { machine.removeVM(vmId); });
 
     m_vmIndex.erase(it);
+
     delete vmPtr;
     return true;
 }
@@ -353,22 +956,9 @@ Resources DataCenter::getResourceUtilizations() const
     Resources result;
 
     // Result will have the used/total ratio for turned on machines
-    Resources total;
-    Resources used;
-    size_t count = 0;
-    for (const auto &pm : m_physicalMachines)
-    {
-        if (pm.isTurnedOn())
-        {
-            total += pm.getTotal();
-            used += pm.getUsed();
-            count++;
-        }
-    }
-
-    if (count > 0)
+    if (m_fleetStatistics.getTurnedOnMachineCount() > 0)
     {
-        result = used / total * 100.0;
+        result = m_fleetStatistics.getUsedResources() / m_fleetStatistics.getTotalResources() * 100.0;
     }
 
     return result;
@@ -376,33 +966,15 @@ Resources DataCenter::getResourceUtilizations() const
 
 size_t DataCenter::getTurnedOnMachineCount() const
 {
-    size_t count = 0;
-    for (const auto &pm : m_physicalMachines)
-    {
-        if (pm.isTurnedOn())
-        {
-            count++;
-        }
-    }
-    return count;
+    return m_fleetStatistics.getTurnedOnMachineCount();
 }
 
 double DataCenter::getAveragePowerConsumption() const
 {
-    double total = 0.0;
-    size_t count = 0;
-    for (const auto &pm : m_physicalMachines)
-    {
-        if (pm.isTurnedOn())
-        {
-            total += pm.getPowerConsumption();
-            count++;
-        }
-    }
-
+    size_t count = m_fleetStatistics.getTurnedOnMachineCount();
     if (count > 0)
     {
-        return total / count;
+        return m_fleetStatistics.getTotalPowerConsumption() / count;
     }
 
     return 0.0;
@@ -410,15 +982,7 @@ double DataCenter::getAveragePowerConsumption() const
 
 double DataCenter::getTotalPowerConsumption() const
 {
-    double total = 0.0;
-    for (const auto &pm : m_physicalMachines)
-    {
-        if (pm.isTurnedOn())
-        {
-            total += pm.getPowerConsumption();
-        }
-    }
-    return total;
+    return m_fleetStatistics.getTotalPowerConsumption();
 }
 
 size_t DataCenter::getNumberOfSLAViolations() const
@@ -432,54 +996,12 @@ void DataCenter::placeVMonPM(VirtualMachine *vm, int pmId, SimulationEngine &eng
     PhysicalMachine *pm = &m_physicalMachines[pmId];
     if (!pm->canHost(usage - Resources(1e-6, 1e-6, 1e-6, 1e-6, 1e-6)))
     {
-        if (dynamic_cast<PAPSOStrategy *>(m_strategy))
-        {
-            // Try random PMs until we find a fit
-            std::random_device rd;
-            std::mt19937 gen(rd());
-            std::uniform_int_distribution<> dis(0, m_physicalMachines.size() - 1);
-            int randomPmId = dis(gen);
-            size_t trialCount = 0;
-            bool found = true;
-            while (randomPmId == pmId || !(m_physicalMachines[randomPmId].isTurnedOn() && m_physicalMachines[randomPmId].canHost(usage - Resources(1e-6, 1e-6, 1e-6, 1e-6, 1e-6))))
-            {
-                randomPmId = dis(gen);
-                if (++trialCount == m_physicalMachines.size())
-                {
-                    LogManager::instance().log(LogCategory::WARNING, "No Turned on PM found for VM " + std::to_string(vm->getID()) + " after " + std::to_string(trialCount) + " trials");
-                    found = false;
-                    break;
-                }
-            }
-
-            if (!found)
-            {
-                // Could not find any turned on PMs, look for other ones
-                trialCount = 0;
-                while (randomPmId == pmId || !m_physicalMachines[randomPmId].canHost(usage - Resources(1e-6, 1e-6, 1e-6, 1e-6, 1e-6)))
-                {
-                    randomPmId = dis(gen);
-                    if (++trialCount == m_physicalMachines.size())
-                    {
-                        LogManager::instance().log(LogCategory::WARNING, "No PM found for VM " + std::to_string(vm->getID()) + " after " + std::to_string(trialCount) + " trials");
-                        throw std::runtime_error("No PM found for VM " + std::to_string(vm->getID()) + " after " + std::to_string(trialCount) + " trials");
-                    }
-                }
-            }
-
-            pmId = randomPmId;
-
-            pm = &m_physicalMachines[pmId];
-
-            LogManager::instance().log(LogCategory::WARNING, "VM " + std::to_string(vm->getID()) + " placed on PM " + std::to_string(pmId) + "(Turned on: " + std::to_string(pm->isTurnedOn()) + ") after " + std::to_string(trialCount) + " trials");
-        }
-        else
-        {
-            throw std::runtime_error("PM " + std::to_string(pm->getID()) + " cannot host VM" + std::to_string(vm->getID()));
-        }
+        // Decisions are repaired in commitDecisions, this is a bug in the repair stage
+        throw std::runtime_error("PM " + std::to_string(pm->getID()) + " cannot host VM" + std::to_string(vm->getID()));
     }
 
-    pm->addVM(vm);
+    mutateMachine(*pm, [vm](PhysicalMachine &machine)
+                  { machine.addVM(vm); });
 
     // insert in vmIndex
     {
@@ -0,0 +1,223 @@
+#include "MigrationCandidateSet.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+    // Same estimate as DataCenter::computeMigrationTime for a single migration
+    double estimateMigrationTime(const VirtualMachine *vm)
+    {
+        auto usage = vm->getUsage();
+        return usage.disk / (usage.bandwidth / 1000);
+    }
+
+    Resources positivePart(const Resources &r)
+    {
+        return Resources(std::max(0.0, r.cpu), std::max(0.0, r.ram), std::max(0.0, r.disk), std::max(0.0, r.bandwidth), std::max(0.0, r.fpga));
+    }
+
+    bool covers(const Resources &relief, const Resources &excess)
+    {
+        return relief.cpu >= excess.cpu && relief.ram >= excess.ram && relief.disk >= excess.disk && relief.bandwidth >= excess.bandwidth && relief.fpga >= excess.fpga;
+    }
+}
+
+std::vector<MigrationSelectionPolicyInfo> MigrationCandidateSet::availablePolicies()
+{
+    return {
+        {MigrationSelectionPolicy::AllVMs, "All VMs"},
+        {MigrationSelectionPolicy::MinimumMigrationTime, "Minimum Migration Time"},
+        {MigrationSelectionPolicy::MinimumExcessKnapsack, "Minimum Excess Knapsack"},
+    };
+}
+
+size_t MigrationCandidateSet::addFromMachine(const PhysicalMachine &pm, double threshold)
+{
+    // Load above the threshold that has to leave the PM, minus what is already queued from it
+    Resources excess = positivePart(pm.getUsed() - pm.getTotal() * threshold);
+
+    std::vector<VirtualMachine *> available;
+    available.reserve(pm.getVirtualMachines().size());
+    for (auto *vm : pm.getVirtualMachines())
+    {
+        if (vm->isMigrating())
+        {
+            continue; // skip already in migration
+        }
+
+        if (contains(vm->getID()))
+        {
+            excess -= vm->getUsage();
+            continue;
+        }
+
+        available.push_back(vm);
+    }
+    excess = positivePart(excess);
+
+    std::vector<VirtualMachine *> selected;
+    switch (m_policy)
+    {
+    case MigrationSelectionPolicy::AllVMs:
+        selected = available;
+        break;
+    case MigrationSelectionPolicy::MinimumMigrationTime:
+        if (excess != Resources(0, 0, 0, 0, 0))
+            selected = selectMinimumMigrationTime(available, excess);
+        break;
+    case MigrationSelectionPolicy::MinimumExcessKnapsack:
+        if (excess != Resources(0, 0, 0, 0, 0))
+            selected = selectMinimumExcessKnapsack(available, excess, pm.getTotal());
+        break;
+    }
+
+    for (auto *vm : selected)
+    {
+        m_queuedIds.insert(vm->getID());
+        m_candidates.push_back(vm);
+    }
+
+    return selected.size();
+}
+
+void MigrationCandidateSet::remove(int vmId)
+{
+    if (m_queuedIds.erase(vmId) == 0)
+        return;
+
+    m_candidates.erase(std::remove_if(m_candidates.begin(), m_candidates.end(), [vmId](VirtualMachine *vm)
+                                      { return vm->getID() == vmId; }),
+                       m_candidates.end());
+}
+
+void MigrationCandidateSet::clear()
+{
+    m_candidates.clear();
+    m_queuedIds.clear();
+}
+
+std::vector<VirtualMachine *> MigrationCandidateSet::selectMinimumMigrationTime(std::vector<VirtualMachine *> &vms, const Resources &excess) const
+{
+    std::sort(vms.begin(), vms.end(), [](VirtualMachine *a, VirtualMachine *b)
+              { return estimateMigrationTime(a) < estimateMigrationTime(b); });
+
+    std::vector<VirtualMachine *> selected;
+    Resources relief;
+    for (auto *vm : vms)
+    {
+        if (covers(relief, excess))
+            break;
+
+        // Skip VMs that do not relieve any of the exceeded dimensions
+        Resources usage = vm->getUsage();
+        bool helps = (excess.cpu > relief.cpu && usage.cpu > 0) || (excess.ram > relief.ram && usage.ram > 0) || (excess.disk > relief.disk && usage.disk > 0) ||
+                     (excess.bandwidth > relief.bandwidth && usage.bandwidth > 0) || (excess.fpga > relief.fpga && usage.fpga > 0);
+        if (!helps)
+            continue;
+
+        relief += usage;
+        selected.push_back(vm);
+    }
+    return selected;
+}
+
+std::vector<VirtualMachine *> MigrationCandidateSet::selectMinimumExcessKnapsack(std::vector<VirtualMachine *> &vms, const Resources &excess, const Resources &total) const
+{
+    // Solve a min-knapsack on the most exceeded dimension: cover its excess with the least migrated load
+    Resources normalized = excess / total;
+    auto dimension = [&normalized]() -> double Resources::*
+    {
+        double Resources::*best = &Resources::cpu;
+        for (auto dim : {&Resources::ram, &Resources::disk, &Resources::bandwidth, &Resources::fpga})
+        {
+            if (normalized.*dim > normalized.*best)
+                best = dim;
+        }
+        return best;
+    }();
+
+    constexpr int UNITS = 100; // resolution of the excess
+    const double unit = excess.*dimension / UNITS;
+    const int n = static_cast<int>(vms.size());
+
+    // dp[i][c] = (migrated load, VM count) covering c units with the first i VMs, parent[i][c] = cell it came from
+    const std::pair<double, int> unreachable{std::numeric_limits<double>::infinity(), 0};
+    std::vector<std::vector<std::pair<double, int>>> dp(n + 1, std::vector<std::pair<double, int>>(UNITS + 1, unreachable));
+    std::vector<std::vector<int>> parent(n + 1, std::vector<int>(UNITS + 1, -1));
+    dp[0][0] = {0.0, 0};
+
+    for (int i = 0; i < n; ++i)
+    {
+        dp[i + 1] = dp[i]; // not taking VM i
+
+        double load = vms[i]->getUsage().*dimension;
+        if (load <= 0)
+            continue;
+
+        int weight = static_cast<int>(std::ceil(load / unit));
+        for (int c = 0; c <= UNITS; ++c)
+        {
+            if (dp[i][c] == unreachable)
+                continue;
+
+            int target = std::min(UNITS, c + weight);
+            std::pair<double, int> candidate{dp[i][c].first + load, dp[i][c].second + 1};
+            if (candidate < dp[i + 1][target])
+            {
+                dp[i + 1][target] = candidate;
+                parent[i + 1][target] = c;
+            }
+        }
+    }
+
+    std::vector<VirtualMachine *> selected;
+    std::vector<char> taken(n, 0);
+    if (dp[n][UNITS] != unreachable)
+    {
+        int c = UNITS;
+        for (int i = n; i > 0; --i)
+        {
+            if (parent[i][c] < 0)
+                continue; // VM i - 1 was not taken for this cell
+
+            taken[i - 1] = 1;
+            selected.push_back(vms[i - 1]);
+            c = parent[i][c];
+        }
+    }
+
+    // Other dimensions may still be over the threshold, top up with the largest contributors
+    Resources relief;
+    for (auto *vm : selected)
+        relief += vm->getUsage();
+
+    if (!covers(relief, excess))
+    {
+        std::vector<int> rest;
+        for (int i = 0; i < n; ++i)
+        {
+            if (!taken[i])
+                rest.push_back(i);
+        }
+
+        while (!covers(relief, excess) && !rest.empty())
+        {
+            Resources missing = positivePart(excess - relief) / total;
+            auto score = [&](int i)
+            {
+                Resources usage = vms[i]->getUsage() / total;
+                return std::min(usage.cpu, missing.cpu) + std::min(usage.ram, missing.ram) + std::min(usage.disk, missing.disk) +
+                       std::min(usage.bandwidth, missing.bandwidth) + std::min(usage.fpga, missing.fpga);
+            };
+            auto best = std::max_element(rest.begin(), rest.end(), [&](int a, int b)
+                                         { return score(a) < score(b); });
+
+            relief += vms[*best]->getUsage();
+            selected.push_back(vms[*best]);
+            rest.erase(best);
+        }
+    }
+
+    return selected;
+}
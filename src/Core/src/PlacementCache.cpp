@@ -0,0 +1,315 @@
+#include "PlacementCache.h"
+#include "strategies/PlacementCostModel.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <unordered_set>
+
+namespace
+{
+    constexpr size_t REQUEST_FIELDS = 7; // kind, source PM and five quantized resources
+
+    long quantize(double value, double step)
+    {
+        return step > 0 ? std::lround(value / step) : 0;
+    }
+
+    uint64_t hashKey(const std::vector<long> &key)
+    {
+        // FNV-1a over the words
+        uint64_t hash = 1469598103934665603ull;
+        for (long word : key)
+        {
+            hash ^= static_cast<uint64_t>(word);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+}
+
+PlacementCache::PlacementCache(size_t capacity, double quantum)
+    : m_capacity(capacity), m_quantum(quantum)
+{
+}
+
+void PlacementCache::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.clear();
+    m_index.clear();
+}
+
+void PlacementCache::setCapacity(size_t capacity)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_capacity = capacity;
+    while (m_entries.size() > m_capacity)
+    {
+        m_index.erase(m_entries.back().signature.hash);
+        m_entries.pop_back();
+    }
+}
+
+size_t PlacementCache::getCapacity() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_capacity;
+}
+
+void PlacementCache::setQuantum(double quantum)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_quantum = quantum;
+    m_steps = Resources();
+    m_entries.clear();
+    m_index.clear();
+}
+
+double PlacementCache::getQuantum() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_quantum;
+}
+
+PlacementCache::Statistics PlacementCache::getStatistics() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_statistics;
+}
+
+size_t PlacementCache::size() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.size();
+}
+
+void PlacementCache::setSteps(const std::vector<PhysicalMachine> &machines)
+{
+    Resources largest;
+    for (auto &machine : machines)
+    {
+        Resources total = machine.getTotal();
+        largest = Resources(std::max(largest.cpu, total.cpu), std::max(largest.ram, total.ram), std::max(largest.disk, total.disk),
+                            std::max(largest.bandwidth, total.bandwidth), std::max(largest.fpga, total.fpga));
+    }
+
+    Resources steps = largest * m_quantum;
+    if (steps.cpu != m_steps.cpu || steps.ram != m_steps.ram || steps.disk != m_steps.disk || steps.bandwidth != m_steps.bandwidth || steps.fpga != m_steps.fpga)
+    {
+        // The fleet changed, the stored keys were quantized differently
+        m_steps = steps;
+        m_entries.clear();
+        m_index.clear();
+    }
+}
+
+std::vector<long> PlacementCache::fleetSignature(const std::vector<long> &requests, const std::vector<size_t> &order, const std::vector<PhysicalMachine> &machines) const
+{
+    // Per class of identical requests, the turned on PMs other than the source that could host one,
+    // capped at the size of the class: more room than the class can use does not change the decisions
+    std::vector<const long *> classes;
+    std::vector<long> sizes;
+    for (size_t position : order)
+    {
+        const long *request = requests.data() + position * REQUEST_FIELDS;
+        if (!classes.empty() && std::equal(request, request + REQUEST_FIELDS, classes.back()))
+        {
+            sizes.back()++;
+            continue;
+        }
+        classes.push_back(request);
+        sizes.push_back(1);
+    }
+
+    std::vector<long> hosts(classes.size(), 0);
+    for (auto &machine : machines)
+    {
+        if (!machine.isTurnedOn())
+            continue;
+
+        Resources free = machine.getFreeResources();
+        for (size_t c = 0; c < classes.size(); ++c)
+        {
+            const long *request = classes[c];
+            if (hosts[c] >= sizes[c] || request[1] == machine.getID())
+                continue;
+
+            Resources need(request[2] * m_steps.cpu, request[3] * m_steps.ram, request[4] * m_steps.disk, request[5] * m_steps.bandwidth, request[6] * m_steps.fpga);
+            hosts[c] += canHost(need, free);
+        }
+    }
+    return hosts;
+}
+
+PlacementCache::Signature PlacementCache::signature(const std::vector<VirtualMachine *> &newRequests, const std::vector<VirtualMachine *> &toMigrate, const std::vector<PhysicalMachine> &machines) const
+{
+    const size_t count = newRequests.size() + toMigrate.size();
+
+    std::vector<long> requests;
+    requests.reserve(count * REQUEST_FIELDS);
+    auto add = [&](long kind, long source, const Resources &resources)
+    {
+        requests.insert(requests.end(), {kind, source, quantize(resources.cpu, m_steps.cpu), quantize(resources.ram, m_steps.ram), quantize(resources.disk, m_steps.disk),
+                                         quantize(resources.bandwidth, m_steps.bandwidth), quantize(resources.fpga, m_steps.fpga)});
+    };
+    for (auto *vm : newRequests)
+        add(0, -1, vm->getTotalRequestedResources());
+    for (auto *vm : toMigrate)
+        add(1, vm->getPMID(), vm->getUsage());
+
+    Signature signature;
+    signature.order.resize(count);
+    std::iota(signature.order.begin(), signature.order.end(), 0);
+    std::stable_sort(signature.order.begin(), signature.order.end(), [&requests](size_t a, size_t b)
+                     { return std::lexicographical_compare(requests.begin() + a * REQUEST_FIELDS, requests.begin() + (a + 1) * REQUEST_FIELDS,
+                                                           requests.begin() + b * REQUEST_FIELDS, requests.begin() + (b + 1) * REQUEST_FIELDS); });
+
+    std::vector<long> fleet = fleetSignature(requests, signature.order, machines);
+    signature.key.reserve(requests.size() + fleet.size());
+    for (size_t position : signature.order)
+        signature.key.insert(signature.key.end(), requests.begin() + position * REQUEST_FIELDS, requests.begin() + (position + 1) * REQUEST_FIELDS);
+    signature.key.insert(signature.key.end(), fleet.begin(), fleet.end());
+    signature.hash = hashKey(signature.key);
+
+    return signature;
+}
+
+std::vector<long> PlacementCache::residual(const PhysicalMachine &pm) const
+{
+    Resources free = pm.getFreeResources();
+    return {pm.isTurnedOn() ? 1L : 0L, quantize(free.cpu, m_steps.cpu), quantize(free.ram, m_steps.ram), quantize(free.disk, m_steps.disk),
+            quantize(free.bandwidth, m_steps.bandwidth), quantize(free.fpga, m_steps.fpga)};
+}
+
+bool PlacementCache::lookup(const std::vector<VirtualMachine *> &newRequests, const std::vector<VirtualMachine *> &toMigrate, const std::vector<PhysicalMachine> &machines, Results &decisions)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_statistics.lookups++;
+
+    setSteps(machines);
+    Signature current = signature(newRequests, toMigrate, machines);
+
+    auto found = m_index.find(current.hash);
+    if (found == m_index.end() || found->second->signature.key != current.key)
+        return false;
+
+    const Entry &entry = *found->second;
+
+    // Every PM the decisions use needs a counterpart with the same residuals, PMs with the same
+    // residuals being interchangeable. The stored PM is kept when it still qualifies
+    std::unordered_map<int, size_t> position;
+    for (size_t i = 0; i < machines.size(); ++i)
+        position[machines[i].getID()] = i;
+
+    std::unordered_map<int, int> counterpart; // stored PM id -> current PM id
+    std::unordered_set<int> taken;
+    std::vector<size_t> open;
+    for (size_t k = 0; k < entry.residuals.size(); ++k)
+    {
+        auto &[pmId, stored] = entry.residuals[k];
+        auto it = position.find(pmId);
+        if (it != position.end() && residual(machines[it->second]) == stored)
+        {
+            counterpart[pmId] = pmId;
+            taken.insert(pmId);
+        }
+        else
+            open.push_back(k);
+    }
+    for (size_t i = 0; i < machines.size() && !open.empty(); ++i)
+    {
+        int pmId = machines[i].getID();
+        if (taken.count(pmId))
+            continue;
+
+        std::vector<long> left = residual(machines[i]);
+        auto match = std::find_if(open.begin(), open.end(), [&](size_t k)
+                                  { return entry.residuals[k].second == left; });
+        if (match != open.end())
+        {
+            counterpart[entry.residuals[*match].first] = pmId;
+            taken.insert(pmId);
+            open.erase(match);
+        }
+    }
+    if (!open.empty())
+    {
+        m_statistics.rejected++;
+        return false;
+    }
+
+    Results cached;
+    for (size_t rank = 0; rank < current.order.size(); ++rank)
+    {
+        size_t request = current.order[rank];
+        auto mapped = counterpart.find(entry.targets[rank]);
+        int pmId = mapped != counterpart.end() ? mapped->second : entry.targets[rank];
+        if (request < newRequests.size())
+            cached.placementDecision.push_back({newRequests[request], pmId});
+        else if (pmId >= 0)
+            cached.migrationDecision.push_back({toMigrate[request - newRequests.size()], pmId});
+    }
+
+    // Quantization hides small differences, the decisions must still fit exactly
+    PlacementCostModel model(machines);
+    if (model.evaluate(cached).violations > 0)
+    {
+        m_statistics.rejected++;
+        return false;
+    }
+
+    m_entries.splice(m_entries.begin(), m_entries, found->second);
+    m_statistics.hits++;
+    decisions = std::move(cached);
+    return true;
+}
+
+void PlacementCache::store(const std::vector<VirtualMachine *> &newRequests, const std::vector<VirtualMachine *> &toMigrate, const std::vector<PhysicalMachine> &machines, const Results &decisions)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_capacity == 0)
+        return;
+
+    setSteps(machines);
+
+    Entry entry;
+    entry.signature = signature(newRequests, toMigrate, machines);
+
+    std::unordered_map<const VirtualMachine *, int> target;
+    for (auto &decision : decisions.placementDecision)
+        target[decision.vm] = decision.pmId;
+    for (auto &decision : decisions.migrationDecision)
+        target[decision.vm] = decision.pmId;
+
+    std::unordered_map<int, size_t> position;
+    for (size_t i = 0; i < machines.size(); ++i)
+        position[machines[i].getID()] = i;
+
+    entry.targets.reserve(entry.signature.order.size());
+    for (size_t request : entry.signature.order)
+    {
+        const VirtualMachine *vm = request < newRequests.size() ? newRequests[request] : toMigrate[request - newRequests.size()];
+        auto it = target.find(vm);
+        int pmId = it != target.end() ? it->second : -1;
+        entry.targets.push_back(pmId);
+
+        bool known = std::any_of(entry.residuals.begin(), entry.residuals.end(), [pmId](const std::pair<int, std::vector<long>> &stored)
+                                 { return stored.first == pmId; });
+        auto pm = position.find(pmId);
+        if (pmId >= 0 && !known && pm != position.end())
+            entry.residuals.emplace_back(pmId, residual(machines[pm->second]));
+    }
+
+    auto found = m_index.find(entry.signature.hash);
+    if (found != m_index.end())
+        m_entries.erase(found->second);
+
+    m_entries.push_front(std::move(entry));
+    m_index[m_entries.front().signature.hash] = m_entries.begin();
+
+    while (m_entries.size() > m_capacity)
+    {
+        m_index.erase(m_entries.back().signature.hash);
+        m_entries.pop_back();
+    }
+}
@@ -0,0 +1,342 @@
+#include "PlacementPartitioner.h"
+#include "strategies/StrategyFactory.h"
+#include "logging/LogManager.h"
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+
+namespace
+{
+    // Needs the live data center around its run, see ILPDQNStrategy::setDataCenter
+    const std::string WHOLE_FLEET_STRATEGY = "ILP + DQN Strategy";
+
+    // Budget of a cluster started past the deadline, a zero budget would mean no limit
+    const double MIN_CLUSTER_SECONDS = 1e-6;
+
+    // Share left of the most exhausted dimension once the request is taken
+    double bottleneckShare(const Resources &free, const Resources &need, const Resources &capacity)
+    {
+        const double frees[] = {free.cpu, free.ram, free.disk, free.bandwidth, free.fpga};
+        const double needs[] = {need.cpu, need.ram, need.disk, need.bandwidth, need.fpga};
+        const double capacities[] = {capacity.cpu, capacity.ram, capacity.disk, capacity.bandwidth, capacity.fpga};
+
+        double share = std::numeric_limits<double>::infinity();
+        for (int d = 0; d < 5; ++d)
+        {
+            if (capacities[d] > 0)
+                share = std::min(share, (frees[d] - needs[d]) / capacities[d]);
+        }
+        return share;
+    }
+}
+
+PlacementPartitioner::PlacementPartitioner()
+{
+}
+
+PlacementPartitioner::~PlacementPartitioner()
+{
+    for (auto *strategy : m_strategies)
+    {
+        delete strategy;
+    }
+}
+
+void PlacementPartitioner::setClusterSize(size_t machines)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_clusterSize = machines;
+}
+
+size_t PlacementPartitioner::getClusterSize() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_clusterSize;
+}
+
+void PlacementPartitioner::setStrategyName(const std::string &name)
+{
+    if (name == WHOLE_FLEET_STRATEGY)
+        throw std::runtime_error(name + " observes the whole data center and cannot run per cluster");
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_strategyName = name;
+}
+
+void PlacementPartitioner::invalidateStrategies()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_strategiesStale = true;
+}
+
+std::string PlacementPartitioner::getStrategyName() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_strategyName;
+}
+
+void PlacementPartitioner::setThreadCount(unsigned threads)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_threads = threads;
+}
+
+unsigned PlacementPartitioner::getThreadCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_threads;
+}
+
+bool PlacementPartitioner::appliesTo(const std::vector<PhysicalMachine> &machines) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_clusterSize > 0 && machines.size() > m_clusterSize;
+}
+
+PlacementPartitioner::Statistics PlacementPartitioner::getStatistics() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_statistics;
+}
+
+std::vector<PlacementPartitioner::Cluster> PlacementPartitioner::partition(const std::vector<PhysicalMachine> &machines, size_t clusterSize) const
+{
+    int maxID = -1;
+    for (auto &pm : machines)
+        maxID = std::max(maxID, pm.getID());
+
+    std::vector<Cluster> clusters(maxID / clusterSize + 1);
+    for (size_t i = 0; i < machines.size(); ++i)
+    {
+        const PhysicalMachine &pm = machines[i];
+        Cluster &cluster = clusters[pm.getID() / clusterSize];
+
+        Resources total = pm.getTotal();
+        Resources free = total - pm.getReservedUsages();
+        free = Resources(std::max(0.0, free.cpu), std::max(0.0, free.ram), std::max(0.0, free.disk), std::max(0.0, free.bandwidth), std::max(0.0, free.fpga));
+
+        cluster.positions.push_back(i);
+        cluster.capacity += total;
+        cluster.free += free;
+        cluster.largestFree = Resources(std::max(cluster.largestFree.cpu, free.cpu), std::max(cluster.largestFree.ram, free.ram), std::max(cluster.largestFree.disk, free.disk),
+                                        std::max(cluster.largestFree.bandwidth, free.bandwidth), std::max(cluster.largestFree.fpga, free.fpga));
+    }
+
+    // Gaps in the ids leave empty ranges
+    clusters.erase(std::remove_if(clusters.begin(), clusters.end(), [](const Cluster &cluster)
+                                  { return cluster.positions.empty(); }),
+                   clusters.end());
+    return clusters;
+}
+
+int PlacementPartitioner::route(const Resources &need, std::vector<Cluster> &clusters) const
+{
+    // The cluster with the most room left where some PM may still fit, any cluster when none qualifies
+    int best = -1, bestAny = -1;
+    double bestShare = -std::numeric_limits<double>::infinity(), bestAnyShare = bestShare;
+    for (size_t c = 0; c < clusters.size(); ++c)
+    {
+        double share = bottleneckShare(clusters[c].free, need, clusters[c].capacity);
+        if (share > bestAnyShare)
+        {
+            bestAny = c;
+            bestAnyShare = share;
+        }
+        if (share > bestShare && share >= 0 && canHost(need, clusters[c].largestFree))
+        {
+            best = c;
+            bestShare = share;
+        }
+    }
+
+    int chosen = best >= 0 ? best : bestAny;
+    if (chosen >= 0)
+        clusters[chosen].free -= need;
+    return chosen;
+}
+
+void PlacementPartitioner::prepareStrategies(size_t count, const std::string &name, const IPlacementStrategy *placementStrategy, bool stale)
+{
+    const IPlacementStrategy *source = name.empty() ? placementStrategy : nullptr;
+    if (name != m_strategiesName || source != m_strategiesSource || (source && stale))
+    {
+        for (auto *strategy : m_strategies)
+        {
+            delete strategy;
+        }
+        m_strategies.clear();
+        m_strategiesName = name;
+        m_strategiesSource = source;
+    }
+
+    while (m_strategies.size() < count)
+    {
+        IPlacementStrategy *strategy = nullptr;
+        if (!name.empty())
+        {
+            strategy = StrategyFactory::create(QString::fromStdString(name));
+            if (!strategy)
+                throw std::runtime_error("Unknown placement strategy " + name);
+        }
+        else
+        {
+            if (!source)
+                throw std::runtime_error("No placement strategy to copy per cluster");
+            strategy = source->clone();
+            if (!strategy)
+                throw std::runtime_error(source->name().toStdString() + " cannot be copied per cluster");
+        }
+        m_strategies.push_back(strategy);
+    }
+}
+
+Results PlacementPartitioner::solve(const std::vector<VirtualMachine *> &newRequests, const std::vector<VirtualMachine *> &toMigrate, const std::vector<PhysicalMachine> &machines, const PlacementBudget &budget,
+                                    const IPlacementStrategy *placementStrategy)
+{
+    std::lock_guard<std::mutex> solveLock(m_solveMutex);
+    BudgetTracker tracker(budget);
+
+    size_t clusterSize;
+    std::string name;
+    unsigned threads;
+    bool stale;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        clusterSize = std::max<size_t>(m_clusterSize, 1);
+        name = m_strategyName;
+        threads = m_threads;
+        stale = m_strategiesStale;
+        m_strategiesStale = false;
+    }
+
+    std::vector<Cluster> clusters = partition(machines, clusterSize);
+    std::unordered_map<int, int> clusterOf; // PM id -> cluster
+    for (size_t c = 0; c < clusters.size(); ++c)
+    {
+        for (size_t position : clusters[c].positions)
+            clusterOf[machines[position].getID()] = c;
+    }
+
+    // Migrations stay in the cluster of their source PM
+    for (auto *vm : toMigrate)
+    {
+        auto source = clusterOf.find(vm->getPMID());
+        int c = source != clusterOf.end() ? source->second : route(vm->getUsage(), clusters);
+        if (c >= 0)
+            clusters[c].toMigrate.push_back(vm);
+    }
+    for (auto *vm : newRequests)
+    {
+        int c = route(vm->getTotalRequestedResources(), clusters);
+        if (c >= 0)
+            clusters[c].newRequests.push_back(vm);
+    }
+
+    std::vector<size_t> active;
+    for (size_t c = 0; c < clusters.size(); ++c)
+    {
+        if (!clusters[c].newRequests.empty() || !clusters[c].toMigrate.empty())
+            active.push_back(c);
+    }
+    prepareStrategies(clusters.size(), name, placementStrategy, stale);
+
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = std::max(1u, std::min<unsigned>(threads, active.size()));
+
+    // Each worker takes every threads-th active cluster, a cluster sees a copy of its PMs only. The
+    // clusters share the caller's deadline: with fewer threads than clusters, a cluster gets an even
+    // share of what is left to the clusters still ahead on its thread, and at least a moment to
+    // return its first solution
+    std::vector<Results> clusterResults(active.size());
+    std::vector<std::exception_ptr> errors(active.size());
+    auto work = [&](unsigned t)
+    {
+        for (size_t k = t; k < active.size(); k += threads)
+        {
+            Cluster &cluster = clusters[active[k]];
+            try
+            {
+                std::vector<PhysicalMachine> local;
+                local.reserve(cluster.positions.size());
+                for (size_t position : cluster.positions)
+                    local.push_back(machines[position]);
+                PlacementBudget clusterBudget = budget;
+                if (budget.wallSeconds > 0)
+                {
+                    size_t ahead = (active.size() - k + threads - 1) / threads;
+                    clusterBudget.wallSeconds = std::max(tracker.remaining() / ahead, MIN_CLUSTER_SECONDS);
+                }
+                clusterResults[k] = m_strategies[active[k]]->runBudgeted(cluster.newRequests, cluster.toMigrate, local, clusterBudget);
+            }
+            catch (...)
+            {
+                errors[k] = std::current_exception();
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned t = 1; t < threads; ++t)
+    {
+        workers.emplace_back(work, t);
+    }
+    work(0);
+    for (auto &worker : workers)
+    {
+        worker.join();
+    }
+    for (auto &error : errors)
+    {
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+    // New requests merge in the order of the bundle, those no cluster took stay unplaced. Migrations
+    // are forwarded as returned, a candidate a strategy left out stays where it is
+    std::unordered_map<VirtualMachine *, int> placed;
+    Results results;
+    size_t unplaced = 0;
+    for (auto &clusterResult : clusterResults)
+    {
+        for (auto &decision : clusterResult.placementDecision)
+            placed[decision.vm] = decision.pmId;
+        for (auto &decision : clusterResult.migrationDecision)
+        {
+            unplaced += decision.pmId < 0;
+            results.migrationDecision.push_back(decision);
+        }
+
+        if (!std::isnan(clusterResult.quality.objective))
+            results.quality.objective = std::isnan(results.quality.objective) ? clusterResult.quality.objective : results.quality.objective + clusterResult.quality.objective;
+        if (!std::isnan(clusterResult.quality.gap))
+            results.quality.gap = std::isnan(results.quality.gap) ? clusterResult.quality.gap : std::max(results.quality.gap, clusterResult.quality.gap);
+        results.quality.iterations += clusterResult.quality.iterations;
+        results.quality.complete = results.quality.complete && clusterResult.quality.complete;
+    }
+
+    results.placementDecision.reserve(newRequests.size());
+    for (auto *vm : newRequests)
+    {
+        auto decision = placed.find(vm);
+        int pmId = decision != placed.end() ? decision->second : -1;
+        unplaced += pmId < 0;
+        results.placementDecision.push_back({vm, pmId});
+    }
+    results.quality.seconds = tracker.elapsed();
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_statistics.runs++;
+        m_statistics.clusters = clusters.size();
+        m_statistics.activeClusters = active.size();
+        m_statistics.unplaced += unplaced;
+    }
+
+    LogManager::instance().log(LogCategory::PLACEMENT, "Placed the bundle on " + std::to_string(active.size()) + " of " + std::to_string(clusters.size()) + " clusters with " + std::to_string(threads) + " threads in " + std::to_string(results.quality.seconds) + " s, " + std::to_string(unplaced) + " decisions left to the repair");
+    return results;
+}
@@ -0,0 +1,136 @@
+#include "PlacementRepair.h"
+#include <algorithm>
+#include "logging/LogManager.h"
+
+namespace
+{
+    // Same tolerance as the capacity check of DataCenter::placeVMonPM
+    const Resources EPSILON(1e-6, 1e-6, 1e-6, 1e-6, 1e-6);
+}
+
+size_t PlacementRepair::repair(Results &decisions, const std::vector<PhysicalMachine> &machines)
+{
+    reset(machines);
+
+    // Replay the decisions in commit order and collect the infeasible ones
+    std::vector<PlacementDecision *> infeasibleRequests;
+    for (auto &pd : decisions.placementDecision)
+    {
+        Resources usage = pd.vm->getUsage();
+        if (pd.pmId >= 0 && pd.pmId < static_cast<int>(m_slots.size()) && fits(pd.pmId, usage))
+            commit(pd.pmId, usage);
+        else
+            infeasibleRequests.push_back(&pd);
+    }
+
+    std::vector<PlacementDecision *> infeasibleMigrations;
+    for (auto &pd : decisions.migrationDecision)
+    {
+        if (pd.pmId < 0 || pd.pmId == pd.vm->getPMID())
+            continue; // stays where it is
+
+        // The source keeps the VM until the migration completes, only the target is charged
+        Resources usage = pd.vm->getUsage();
+        if (pd.pmId < static_cast<int>(m_slots.size()) && fits(pd.pmId, usage))
+            commit(pd.pmId, usage);
+        else
+            infeasibleMigrations.push_back(&pd);
+    }
+
+    // Largest VMs first, they have the fewest candidates
+    auto largestFirst = [](PlacementDecision *a, PlacementDecision *b)
+    {
+        return a->vm->getUsage().cpu > b->vm->getUsage().cpu;
+    };
+    std::stable_sort(infeasibleRequests.begin(), infeasibleRequests.end(), largestFirst);
+    std::stable_sort(infeasibleMigrations.begin(), infeasibleMigrations.end(), largestFirst);
+
+    for (auto *pd : infeasibleRequests)
+    {
+        Resources usage = pd->vm->getUsage();
+        int pmId = findBestFit(usage, -1);
+        LogManager::instance().log(LogCategory::PLACEMENT, "Repaired VM " + std::to_string(pd->vm->getID()) + " from PM " + std::to_string(pd->pmId) + " to PM " + std::to_string(pmId));
+        pd->pmId = pmId;
+        if (pmId >= 0)
+            commit(pmId, usage);
+    }
+
+    for (auto *pd : infeasibleMigrations)
+    {
+        Resources usage = pd->vm->getUsage();
+        int pmId = findBestFit(usage, pd->vm->getPMID());
+        LogManager::instance().log(LogCategory::VM_MIGRATION, "Repaired migration of VM " + std::to_string(pd->vm->getID()) + " from PM " + std::to_string(pd->pmId) + " to PM " + std::to_string(pmId));
+        pd->pmId = pmId;
+        if (pmId >= 0)
+            commit(pmId, usage);
+    }
+
+    return infeasibleRequests.size() + infeasibleMigrations.size();
+}
+
+void PlacementRepair::reset(const std::vector<PhysicalMachine> &machines)
+{
+    m_turnedOnPool.clear();
+    m_turnedOffPool.clear();
+    m_slots.resize(machines.size());
+
+    for (size_t i = 0; i < machines.size(); ++i)
+    {
+        auto &slot = m_slots[i];
+        slot.free = machines[i].getFreeResources();
+        slot.turnedOn = machines[i].isTurnedOn();
+        auto &pool = slot.turnedOn ? m_turnedOnPool : m_turnedOffPool;
+        slot.position = pool.emplace(slot.free.cpu, static_cast<int>(i));
+    }
+}
+
+bool PlacementRepair::fits(int pmId, const Resources &usage) const
+{
+    return canHost(usage - EPSILON, m_slots[pmId].free);
+}
+
+void PlacementRepair::commit(int pmId, const Resources &usage)
+{
+    auto &slot = m_slots[pmId];
+    (slot.turnedOn ? m_turnedOnPool : m_turnedOffPool).erase(slot.position);
+
+    // A PM that receives a VM is turned on from here on
+    slot.free -= usage;
+    slot.turnedOn = true;
+    slot.position = m_turnedOnPool.emplace(slot.free.cpu, pmId);
+}
+
+int PlacementRepair::findBestFit(const Resources &usage, int excludedPmId)
+{
+    int pmId = findBestFit(m_turnedOnPool, usage, excludedPmId);
+    if (pmId < 0)
+        pmId = findBestFit(m_turnedOffPool, usage, excludedPmId);
+    return pmId;
+}
+
+int PlacementRepair::findBestFit(const std::multimap<double, int> &pool, const Resources &usage, int excludedPmId)
+{
+    // The smallest free CPU that still hosts the VM, then the remaining dimensions
+    std::vector<int> ties;
+    double tieKey = 0.0;
+    for (auto it = pool.lower_bound(usage.cpu - EPSILON.cpu); it != pool.end(); ++it)
+    {
+        if (!ties.empty() && it->first > tieKey)
+            break;
+
+        if (it->second == excludedPmId || !fits(it->second, usage))
+            continue;
+
+        tieKey = it->first;
+        ties.push_back(it->second);
+    }
+
+    if (ties.empty())
+        return -1;
+
+    if (ties.size() == 1)
+        return ties.front();
+
+    std::uniform_int_distribution<size_t> pick(0, ties.size() - 1);
+    return ties[pick(m_rng)];
+}
@@ -0,0 +1,70 @@
+#include "PlacementScheduler.h"
+#include <algorithm>
+#include <cmath>
+
+void PlacementScheduler::setSizingMode(BundleSizingMode mode)
+{
+    m_sizingMode = mode;
+}
+
+void PlacementScheduler::setBundleSizeLimits(size_t minSize, size_t maxSize)
+{
+    m_minBundleSize = std::max<size_t>(1, minSize);
+    m_maxBundleSize = std::max(m_minBundleSize, maxSize);
+    m_adaptiveBundleSize = std::clamp(m_adaptiveBundleSize, double(m_minBundleSize), double(m_maxBundleSize));
+}
+
+size_t PlacementScheduler::getBundleSize(size_t strategyBundleSize) const
+{
+    if (m_sizingMode == BundleSizingMode::Strategy)
+        return strategyBundleSize;
+
+    return static_cast<size_t>(std::lround(m_adaptiveBundleSize));
+}
+
+void PlacementScheduler::onRequestArrival(double time)
+{
+    if (m_lastArrival >= 0 && time >= m_lastArrival)
+    {
+        double interArrival = time - m_lastArrival;
+        m_meanInterArrival = (m_meanInterArrival > 0) ? EWMA_ALPHA * interArrival + (1 - EWMA_ALPHA) * m_meanInterArrival : interArrival;
+    }
+    m_lastArrival = time;
+}
+
+void PlacementScheduler::onPlacement(size_t bundleSize, double solveSeconds)
+{
+    // Any flush scheduled for the placed bundle is now stale
+    m_generation++;
+    m_lastSolveTime = solveSeconds;
+
+    if (m_sizingMode != BundleSizingMode::Adaptive || bundleSize == 0)
+        return;
+
+    double next = m_adaptiveBundleSize;
+    if (solveSeconds > m_targetSolveTime)
+    {
+        // Too slow, shrink proportionally but at most by half
+        next *= std::max(0.5, m_targetSolveTime / solveSeconds);
+    }
+    else if (solveSeconds < 0.5 * m_targetSolveTime)
+    {
+        // Plenty of headroom, batch more for the strategy
+        next *= 1.25;
+    }
+
+    // Never wait for more requests than arrive within the maximum wait
+    if (m_maxWait > 0 && m_meanInterArrival > 0)
+    {
+        next = std::min(next, m_maxWait / m_meanInterArrival);
+    }
+
+    m_adaptiveBundleSize = std::clamp(next, double(m_minBundleSize), double(m_maxBundleSize));
+}
+
+void PlacementScheduler::onVMPlaced(double delay)
+{
+    m_placedCount++;
+    m_totalDelay += delay;
+    m_maxDelay = std::max(m_maxDelay, delay);
+}
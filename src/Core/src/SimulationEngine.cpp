@@ -61,6 +61,40 @@ void SimulationEngine::runLoop()
 {
     while (!m_stop)
     {
+        if (m_eventBatching)
+        {
+            // Drain every event of the current timestamp as one batch
+            std::vector<std::shared_ptr<IEvent>> batch;
+            if (!m_queue.popBatch(batch))
+            {
+                if (m_stop)
+                    break;
+                continue;
+            }
+            double t = batch.front()->getTime();
+
+            if (t < m_currentTime)
+            {
+                LogManager::instance().log(LogCategory::WARNING, "Event from the past: " + std::to_string(t) + " < " + std::to_string(m_currentTime));
+                throw std::runtime_error("Event from the past");
+            }
+
+            m_currentTime = t;
+
+            m_dataCenter.beginBatch();
+            for (auto &evt : batch)
+            {
+                evt->accept(m_dataCenter, *this);
+            }
+            m_dataCenter.endBatch(*this);
+
+            if (m_recorder)
+            {
+                m_recorder->recordStatistics();
+            }
+            continue;
+        }
+
         std::shared_ptr<IEvent> evt;
         if (!m_queue.pop(evt))
         {
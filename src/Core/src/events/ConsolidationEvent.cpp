@@ -0,0 +1,8 @@
+#include "events/ConsolidationEvent.h"
+#include "DataCenter.h"
+#include "SimulationEngine.h"
+
+void ConsolidationEvent::accept(DataCenter &dc, SimulationEngine &engine)
+{
+    dc.handle(*this, engine);
+}
\ No newline at end of file
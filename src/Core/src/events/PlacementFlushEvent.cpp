@@ -0,0 +1,8 @@
+#include "events/PlacementFlushEvent.h"
+#include "DataCenter.h"
+#include "SimulationEngine.h"
+
+void PlacementFlushEvent::accept(DataCenter &dc, SimulationEngine &engine)
+{
+    dc.handle(*this, engine);
+}
\ No newline at end of file
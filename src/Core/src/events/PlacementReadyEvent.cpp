@@ -0,0 +1,8 @@
+#include "events/PlacementReadyEvent.h"
+#include "DataCenter.h"
+#include "SimulationEngine.h"
+
+void PlacementReadyEvent::accept(DataCenter &dc, SimulationEngine &engine)
+{
+    dc.handle(*this, engine);
+}
\ No newline at end of file
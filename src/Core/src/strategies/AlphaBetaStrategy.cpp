@@ -113,6 +113,14 @@ QString AlphaBetaStrategy::name() const
     return "AlphaBetaStrategy";
 }
 
+IPlacementStrategy *AlphaBetaStrategy::clone() const
+{
+    auto *copy = new AlphaBetaStrategy();
+    copy->m_alpha = m_alpha;
+    copy->m_beta = m_beta;
+    return copy;
+}
+
 QWidget *AlphaBetaStrategy::createStatusWidget(QWidget *parent)
 {
     if (!m_statusWidget)
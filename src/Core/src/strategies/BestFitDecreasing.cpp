@@ -85,7 +85,7 @@ Results BestFitDecreasing::run(const std::vector<VirtualMachine *> &newRequests,
     results.migrationDecision.reserve(toMigrate.size());
 
     // For each VM in descending order, do a "Best Fit"
-    for (auto *vm : sortedNew)
+    for (auto *vm : sortedMig)
     {
         Resources need = vm->getTotalRequestedResources();
         int bestIdx = -1;
@@ -152,6 +152,12 @@ QString BestFitDecreasing::name() const
     return "BestFitDecreasing";
 }
 
+IPlacementStrategy *BestFitDecreasing::clone() const
+{
+    // No parameters
+    return new BestFitDecreasing();
+}
+
 QWidget *BestFitDecreasing::createStatusWidget(QWidget *parent)
 {
     if (!m_statusWidget)
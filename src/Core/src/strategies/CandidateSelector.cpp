@@ -0,0 +1,114 @@
+#include "strategies/CandidateSelector.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+double CandidateSelector::calculatePowerOnCost(const PhysicalMachine &machine)
+{
+    return machine.getPowerOnCost() + machine.getPowerConsumptionCPU() * 4.0 + machine.getPowerConsumptionFPGA() * 2.0;
+}
+
+void CandidateSelector::sortPool(const std::vector<PhysicalMachine> &machines)
+{
+    // Power on costs are fixed per PM, the order only changes with the PMs of the fleet. Snapshots
+    // and clusters are copies that may reuse an address, so the fleet is told apart by its ids
+    bool sameFleet = m_poolIds.size() == machines.size();
+    for (size_t i = 0; sameFleet && i < machines.size(); ++i)
+        sameFleet = m_poolIds[i] == machines[i].getID();
+    if (sameFleet)
+        return;
+
+    m_pool.resize(machines.size());
+    for (size_t i = 0; i < machines.size(); ++i)
+        m_pool[i] = i;
+
+    std::vector<double> costs(machines.size());
+    for (size_t i = 0; i < machines.size(); ++i)
+        costs[i] = calculatePowerOnCost(machines[i]);
+
+    std::stable_sort(m_pool.begin(), m_pool.end(), [&costs](int a, int b)
+                     { return costs[a] < costs[b]; });
+
+    m_poolIds.resize(machines.size());
+    for (size_t i = 0; i < machines.size(); ++i)
+        m_poolIds[i] = machines[i].getID();
+}
+
+void CandidateSelector::selectTurnedOn(const std::vector<VirtualMachine *> &vms, const std::vector<PhysicalMachine> &machines)
+{
+    if (m_maxTurnedOn == 0)
+    {
+        for (auto &machine : machines)
+        {
+            if (machine.isTurnedOn())
+                m_candidates.push_back(&machine);
+        }
+        return;
+    }
+
+    // Residual fit: PMs that host an average VM of the bundle with the least CPU left over come
+    // first, then PMs that only host the smallest VM, PMs that host none are skipped
+    Resources mean(0, 0, 0, 0, 0);
+    const double inf = std::numeric_limits<double>::infinity();
+    Resources smallest(inf, inf, inf, inf, inf);
+    for (auto *vm : vms)
+    {
+        Resources demand = vm->getTotalRequestedResources();
+        mean += demand;
+        smallest = Resources(std::min(smallest.cpu, demand.cpu), std::min(smallest.ram, demand.ram), std::min(smallest.disk, demand.disk),
+                             std::min(smallest.bandwidth, demand.bandwidth), std::min(smallest.fpga, demand.fpga));
+    }
+    if (!vms.empty())
+        mean /= double(vms.size());
+
+    m_ranked.clear();
+    for (auto &machine : machines)
+    {
+        if (!machine.isTurnedOn() || !machine.canHost(smallest))
+            continue;
+
+        double leftover = machine.getFreeResources().cpu - mean.cpu;
+        m_ranked.push_back({{machine.canHost(mean) ? 0 : 1, leftover}, &machine});
+    }
+
+    size_t count = std::min(m_maxTurnedOn, m_ranked.size());
+    std::partial_sort(m_ranked.begin(), m_ranked.begin() + count, m_ranked.end(), [](const auto &a, const auto &b)
+                      { return a.first < b.first; });
+    for (size_t i = 0; i < count; ++i)
+        m_candidates.push_back(m_ranked[i].second);
+}
+
+const std::vector<const PhysicalMachine *> &CandidateSelector::select(const std::vector<VirtualMachine *> &vms, const std::vector<PhysicalMachine> &machines)
+{
+    m_candidates.clear();
+    selectTurnedOn(vms, machines);
+
+    // Componentwise largest VM of the bundle, a turned off PM must host it to be useful
+    Resources largest(0, 0, 0, 0, 0);
+    for (auto *vm : vms)
+    {
+        Resources demand = vm->getTotalRequestedResources();
+        largest = Resources(std::max(largest.cpu, demand.cpu), std::max(largest.ram, demand.ram), std::max(largest.disk, demand.disk),
+                            std::max(largest.bandwidth, demand.bandwidth), std::max(largest.fpga, demand.fpga));
+    }
+
+    sortPool(machines);
+    size_t numExtraPMsToInclude = static_cast<size_t>(std::ceil(m_extraMachineCoefficient * vms.size()));
+    for (size_t k = 0; k < m_pool.size() && numExtraPMsToInclude > 0; ++k)
+    {
+        const PhysicalMachine &machine = machines[m_pool[k]];
+        if (machine.isTurnedOn() || !machine.canHost(largest))
+            continue;
+
+        m_candidates.push_back(&machine);
+        numExtraPMsToInclude--;
+    }
+
+    // Nothing turned on and nothing fits, search the whole fleet
+    if (m_candidates.empty())
+    {
+        for (auto &machine : machines)
+            m_candidates.push_back(&machine);
+    }
+    return m_candidates;
+}
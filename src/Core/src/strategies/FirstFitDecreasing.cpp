@@ -136,6 +136,12 @@ QString FirstFitDecreasing::name() const
     return "FirstFitDecreasing";
 }
 
+IPlacementStrategy *FirstFitDecreasing::clone() const
+{
+    // No parameters
+    return new FirstFitDecreasing();
+}
+
 QWidget *FirstFitDecreasing::createStatusWidget(QWidget *parent)
 {
     if (!m_statusWidget)
@@ -0,0 +1,342 @@
+#include "strategies/HarmonicStrategy.h"
+#include "logging/LogManager.h"
+#include <algorithm>
+#include <chrono>
+#include <unordered_set>
+
+HarmonicStrategy::HarmonicStrategy()
+{
+}
+
+HarmonicStrategy::~HarmonicStrategy()
+{
+}
+
+Results HarmonicStrategy::run(const std::vector<VirtualMachine *> &newRequests, const std::vector<VirtualMachine *> &toMigrate, const std::vector<PhysicalMachine> &machines)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    m_runs++;
+    if (needsResync(machines) || (m_resyncInterval > 0 && m_runs % m_resyncInterval == 0))
+        resync(machines);
+    m_added.clear();
+
+    Results results;
+    results.placementDecision.reserve(newRequests.size());
+    results.migrationDecision.reserve(toMigrate.size());
+
+    // Online, in arrival order: sorting the bundle would cost more than placing it
+    for (auto *vm : newRequests)
+    {
+        int position = place(vm->getTotalRequestedResources(), -1, machines);
+        results.placementDecision.push_back({vm, position >= 0 ? machines[position].getID() : -1});
+    }
+
+    for (auto *vm : toMigrate)
+    {
+        int source = vm->getPMID() >= 0 && vm->getPMID() < int(m_position.size()) ? m_position[vm->getPMID()] : -1;
+        int position = place(vm->getTotalRequestedResources(), source, machines);
+        results.migrationDecision.push_back({vm, position >= 0 ? machines[position].getID() : -1});
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (m_sampleInterval > 0 && m_runs % m_sampleInterval == 0)
+        sampleEfficiency(newRequests, toMigrate, machines, results, seconds);
+
+    return results;
+}
+
+int HarmonicStrategy::classify(const Resources &need) const
+{
+    double share = 0;
+    const double needs[] = {need.cpu, need.ram, need.disk, need.bandwidth, need.fpga};
+    const double references[] = {m_reference.cpu, m_reference.ram, m_reference.disk, m_reference.bandwidth, m_reference.fpga};
+    for (int d = 0; d < 5; ++d)
+    {
+        if (references[d] > 0)
+            share = std::max(share, needs[d] / references[d]);
+    }
+
+    // Class k holds (1/(k+1), 1/k], so k = floor(1/share)
+    if (share <= 1.0 / m_classCount)
+        return m_classCount;
+    return std::max(1, std::min(m_classCount, static_cast<int>(1.0 / share)));
+}
+
+bool HarmonicStrategy::fits(int position, const Resources &need, const std::vector<PhysicalMachine> &machines) const
+{
+    const PhysicalMachine &pm = machines[position];
+    Resources load = pm.getReservedUsages();
+    auto added = m_added.find(position);
+    if (added != m_added.end())
+        load += added->second;
+    return canHost(need, pm.getTotal() - load);
+}
+
+void HarmonicStrategy::commit(int position, const Resources &need)
+{
+    m_added[position] += need;
+}
+
+int HarmonicStrategy::place(const Resources &need, int excluded, const std::vector<PhysicalMachine> &machines)
+{
+    const int k = classify(need);
+    auto &open = m_open[k - 1];
+
+    // Each PM leaves the list once, so the pops are amortized over the requests
+    while (!open.empty() && open.back() != excluded)
+    {
+        int position = open.back();
+        if (fits(position, need, machines))
+        {
+            commit(position, need);
+            return position;
+        }
+        open.pop_back();
+    }
+
+    // Open an empty PM for the class, a PM filled since the last rebuild is dropped from the pool
+    int opened = -1;
+    int skipped = -1;
+    while (opened < 0 && (!m_emptyOn.empty() || !m_emptyOff.empty()))
+    {
+        auto &pool = !m_emptyOn.empty() ? m_emptyOn : m_emptyOff;
+        int position = pool.back();
+        pool.pop_back();
+        if (position == excluded)
+            skipped = position;
+        else if (machines[position].getVirtualMachines().empty() && fits(position, need, machines))
+            opened = position;
+    }
+    if (skipped >= 0)
+        (machines[skipped].isTurnedOn() ? m_emptyOn : m_emptyOff).push_back(skipped);
+    if (opened >= 0)
+    {
+        m_machineClass[opened] = k;
+        open.push_back(opened);
+        commit(opened, need);
+        return opened;
+    }
+
+    // Space other classes left or departures reopened, the only O(PMs) path
+    m_fallbacks++;
+    for (int position = 0; position < int(machines.size()); ++position)
+    {
+        if (position != excluded && fits(position, need, machines))
+        {
+            commit(position, need);
+            return position;
+        }
+    }
+    return -1;
+}
+
+bool HarmonicStrategy::needsResync(const std::vector<PhysicalMachine> &machines) const
+{
+    if (m_machineClass.size() != machines.size() || m_open.size() != size_t(m_classCount))
+        return true;
+    // Cheap check that the fleet is laid out as when the lists were built
+    return !machines.empty() && (machines.back().getID() >= int(m_position.size()) || m_position[machines.back().getID()] != int(machines.size()) - 1);
+}
+
+void HarmonicStrategy::resync(const std::vector<PhysicalMachine> &machines)
+{
+    m_resyncs++;
+
+    m_reference = Resources();
+    int maxID = -1;
+    for (auto &pm : machines)
+    {
+        Resources total = pm.getTotal();
+        m_reference = Resources(std::max(m_reference.cpu, total.cpu), std::max(m_reference.ram, total.ram), std::max(m_reference.disk, total.disk),
+                                std::max(m_reference.bandwidth, total.bandwidth), std::max(m_reference.fpga, total.fpga));
+        maxID = std::max(maxID, pm.getID());
+    }
+
+    m_position.assign(maxID + 1, -1);
+    for (size_t i = 0; i < machines.size(); ++i)
+        m_position[machines[i].getID()] = i;
+
+    // PMs keep their class while they host VMs, PMs first seen take the class of their largest VM
+    std::vector<int> previous = std::move(m_machineClass);
+    if (previous.size() != machines.size())
+        previous.assign(machines.size(), 0);
+    m_machineClass.assign(machines.size(), 0);
+    m_open.assign(m_classCount, {});
+    m_emptyOn.clear();
+    m_emptyOff.clear();
+
+    for (int position = int(machines.size()) - 1; position >= 0; --position)
+    {
+        const PhysicalMachine &pm = machines[position];
+        if (pm.getVirtualMachines().empty())
+        {
+            (pm.isTurnedOn() ? m_emptyOn : m_emptyOff).push_back(position);
+            continue;
+        }
+
+        int k = previous[position];
+        if (k < 1 || k > m_classCount)
+        {
+            k = m_classCount;
+            for (auto *vm : pm.getVirtualMachines())
+                k = std::min(k, classify(vm->getTotalRequestedResources()));
+        }
+        m_machineClass[position] = k;
+        m_open[k - 1].push_back(position);
+    }
+}
+
+void HarmonicStrategy::sampleEfficiency(const std::vector<VirtualMachine *> &newRequests, const std::vector<VirtualMachine *> &toMigrate, const std::vector<PhysicalMachine> &machines, const Results &results, double seconds)
+{
+    auto start = std::chrono::steady_clock::now();
+    Results baseline = m_baseline.run(newRequests, toMigrate, machines);
+    double baselineSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    size_t inUse = 0;
+    for (auto &pm : machines)
+        inUse += !pm.getVirtualMachines().empty();
+
+    // PMs in use after the bundle, the empty ones it opens included
+    auto usedAfter = [&machines, inUse, this](const Results &decisions)
+    {
+        std::unordered_set<int> opened;
+        auto count = [&](const PlacementDecision &decision)
+        {
+            if (decision.pmId < 0 || decision.pmId >= int(m_position.size()) || m_position[decision.pmId] < 0)
+                return;
+            if (machines[m_position[decision.pmId]].getVirtualMachines().empty())
+                opened.insert(decision.pmId);
+        };
+        std::for_each(decisions.placementDecision.begin(), decisions.placementDecision.end(), count);
+        std::for_each(decisions.migrationDecision.begin(), decisions.migrationDecision.end(), count);
+        return inUse + opened.size();
+    };
+
+    size_t harmonicUsed = usedAfter(results);
+    size_t baselineUsed = usedAfter(baseline);
+    double efficiency = harmonicUsed > 0 ? double(baselineUsed) / harmonicUsed : 1.0;
+    double speedup = seconds > 0 ? baselineSeconds / seconds : 1.0;
+
+    m_samples++;
+    m_efficiencySum += efficiency;
+    m_speedupSum += speedup;
+
+    LogManager::instance().log(LogCategory::STRATEGY, "HarmonicStrategy: " + std::to_string(harmonicUsed) + " PMs in use against " + std::to_string(baselineUsed) + " for BestFitDecreasing (efficiency " + std::to_string(efficiency) + "), " + std::to_string(speedup) + "x faster");
+}
+
+double HarmonicStrategy::getMigrationThreshold()
+{
+    return m_MST;
+}
+
+size_t HarmonicStrategy::getBundleSize()
+{
+    return m_bundleSize;
+}
+
+QWidget *HarmonicStrategy::createConfigWidget(QWidget *parent)
+{
+    if (!m_configWidget)
+    {
+        m_configWidget = new QWidget(parent);
+        auto layout = new QFormLayout(m_configWidget);
+
+        m_classCountSpin = new QSpinBox(m_configWidget);
+        m_classCountSpin->setRange(1, 64);
+        m_classCountSpin->setValue(m_classCount);
+        layout->addRow("Size Classes:", m_classCountSpin);
+
+        m_resyncIntervalSpin = new QSpinBox(m_configWidget);
+        m_resyncIntervalSpin->setRange(0, 1000000);
+        m_resyncIntervalSpin->setSpecialValueText("Fleet changes only");
+        m_resyncIntervalSpin->setValue(m_resyncInterval);
+        layout->addRow("Resync Interval (runs):", m_resyncIntervalSpin);
+
+        m_sampleIntervalSpin = new QSpinBox(m_configWidget);
+        m_sampleIntervalSpin->setRange(0, 1000000);
+        m_sampleIntervalSpin->setSpecialValueText("Off");
+        m_sampleIntervalSpin->setValue(m_sampleInterval);
+        layout->addRow("BFD Sample Interval (runs):", m_sampleIntervalSpin);
+
+        m_MSTSpin = new QDoubleSpinBox(m_configWidget);
+        m_MSTSpin->setRange(0.0, 1.0);
+        m_MSTSpin->setSingleStep(0.01);
+        m_MSTSpin->setValue(m_MST);
+        layout->addRow("MST (Migration Start Threshold):", m_MSTSpin);
+
+        m_bundleSizeSpin = new QSpinBox(m_configWidget);
+        m_bundleSizeSpin->setRange(1, 1000);
+        m_bundleSizeSpin->setValue(m_bundleSize);
+        layout->addRow("Bundle Size:", m_bundleSizeSpin);
+
+        m_configWidget->setLayout(layout);
+    }
+
+    return m_configWidget;
+}
+
+void HarmonicStrategy::applyConfigFromUI()
+{
+    int classCount = m_classCountSpin->value();
+    if (classCount != m_classCount)
+    {
+        // The PMs were dedicated to the old classes
+        m_classCount = classCount;
+        m_machineClass.clear();
+    }
+    m_resyncInterval = m_resyncIntervalSpin->value();
+    m_sampleInterval = m_sampleIntervalSpin->value();
+    m_MST = m_MSTSpin->value();
+    m_bundleSize = m_bundleSizeSpin->value();
+}
+
+QString HarmonicStrategy::name() const
+{
+    return "Harmonic Size Classes";
+}
+
+IPlacementStrategy *HarmonicStrategy::clone() const
+{
+    auto *copy = new HarmonicStrategy();
+    copy->m_classCount = m_classCount;
+    copy->m_resyncInterval = m_resyncInterval;
+    copy->m_sampleInterval = m_sampleInterval;
+    copy->m_MST = m_MST;
+    copy->m_bundleSize = m_bundleSize;
+    return copy;
+}
+
+QWidget *HarmonicStrategy::createStatusWidget(QWidget *parent)
+{
+    if (!m_statusWidget)
+    {
+        m_statusWidget = new QWidget(parent);
+        auto layout = new QFormLayout(m_statusWidget);
+
+        auto classCountLabel = new QLabel(QString::number(m_classCount), m_statusWidget);
+        layout->addRow("Size Classes:", classCountLabel);
+
+        auto efficiencyLabel = new QLabel(m_samples > 0 ? QString::number(100.0 * getPackingEfficiency(), 'f', 1) + "% over " + QString::number(m_samples) + " samples" : QString("Not sampled"), m_statusWidget);
+        layout->addRow("Packing Efficiency vs BFD:", efficiencyLabel);
+
+        auto speedupLabel = new QLabel(m_samples > 0 ? QString::number(getSpeedup(), 'f', 1) + "x" : QString("Not sampled"), m_statusWidget);
+        layout->addRow("Speedup vs BFD:", speedupLabel);
+
+        auto fallbackLabel = new QLabel(QString::number(m_fallbacks), m_statusWidget);
+        layout->addRow("Full Scans:", fallbackLabel);
+
+        auto resyncLabel = new QLabel(QString::number(m_resyncs), m_statusWidget);
+        layout->addRow("Resyncs:", resyncLabel);
+
+        auto mstLabel = new QLabel(QString::number(m_MST), m_statusWidget);
+        layout->addRow("MST (Migration Start Threshold):", mstLabel);
+
+        auto bundleSizeLabel = new QLabel(QString::number(m_bundleSize), m_statusWidget);
+        layout->addRow("Bundle Size:", bundleSizeLabel);
+
+        m_statusWidget->setLayout(layout);
+    }
+
+    return m_statusWidget;
+}
@@ -0,0 +1,527 @@
+#include "strategies/ILPModel.h"
+#include "strategies/UtilizationCost.h"
+#include "logging/LogManager.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace
+{
+    constexpr int DIMENSIONS = 5;
+
+    double dimension(const Resources &r, int d)
+    {
+        switch (d)
+        {
+        case 0:
+            return r.cpu;
+        case 1:
+            return r.ram;
+        case 2:
+            return r.disk;
+        case 3:
+            return r.bandwidth;
+        default:
+            return r.fpga;
+        }
+    }
+
+    // Aborts the search once the cancellation token of the running solve is set, CPLEX keeps the incumbent
+    ILOMIPINFOCALLBACK1(CancelCallback, const std::atomic<bool> *const *, cancel)
+    {
+        if (*cancel && (*cancel)->load(std::memory_order_relaxed))
+            abort();
+    }
+
+    // Doubles the current capacity until the request fits
+    int grow(int current, int needed)
+    {
+        int capacity = std::max(current, 1);
+        while (capacity < needed)
+            capacity *= 2;
+        return capacity;
+    }
+}
+
+ILPModel::ILPModel()
+{
+}
+
+ILPModel::~ILPModel()
+{
+    m_env.end();
+}
+
+void ILPModel::build(int machineSlots, int newcomerSlots, int migrationSlots)
+{
+    // Ending the environment releases the previous skeleton and its CPLEX instance
+    if (m_machineSlots > 0)
+    {
+        m_env.end();
+        m_env = IloEnv();
+    }
+
+    LogManager::instance().log(LogCategory::DEBUG, "ILPModel: Building skeleton for " + std::to_string(machineSlots) + " PMs, " + std::to_string(newcomerSlots) + " new requests, and " + std::to_string(migrationSlots) + " migration requests");
+
+    m_model = IloModel(m_env);
+
+    // Every slot starts fixed to 0, update() releases the ones a bundle uses
+    m_xNewcomers = IloArray<IloBoolVarArray>(m_env, newcomerSlots);
+    for (int j = 0; j < newcomerSlots; ++j)
+    {
+        m_xNewcomers[j] = IloBoolVarArray(m_env, machineSlots);
+        for (int i = 0; i < machineSlots; ++i)
+        {
+            m_xNewcomers[j][i] = IloBoolVar(m_env, 0, 0);
+        }
+    }
+
+    m_xMigrations = IloArray<IloBoolVarArray>(m_env, migrationSlots);
+    for (int j = 0; j < migrationSlots; ++j)
+    {
+        m_xMigrations[j] = IloBoolVarArray(m_env, machineSlots);
+        for (int i = 0; i < machineSlots; ++i)
+        {
+            m_xMigrations[j][i] = IloBoolVar(m_env, 0, 0);
+        }
+    }
+
+    m_y = IloBoolVarArray(m_env, machineSlots);
+    for (int i = 0; i < machineSlots; ++i)
+    {
+        m_y[i] = IloBoolVar(m_env, 0, 0);
+    }
+
+    m_migrate = IloBoolVarArray(m_env, migrationSlots);
+    for (int j = 0; j < migrationSlots; ++j)
+    {
+        m_migrate[j] = IloBoolVar(m_env, 0, 0);
+    }
+
+    // Cost coefficients are written per bundle
+    m_objective = IloMinimize(m_env);
+    m_model.add(m_objective);
+
+    // Constraint 1: Each request can only be assigned to one PM, unused slots get [0, 0]
+    m_assignment = IloRangeArray(m_env, newcomerSlots);
+    for (int j = 0; j < newcomerSlots; ++j)
+    {
+        IloExpr sum(m_env);
+        for (int i = 0; i < machineSlots; ++i)
+        {
+            sum += m_xNewcomers[j][i];
+        }
+        m_assignment[j] = IloRange(m_env, 0, sum, 0);
+        sum.end();
+    }
+    m_model.add(m_assignment);
+
+    // Constraint 2: Resource constraints, request sizes and free capacities are written per bundle
+    m_capacity = IloArray<IloRangeArray>(m_env, DIMENSIONS);
+    for (int d = 0; d < DIMENSIONS; ++d)
+    {
+        m_capacity[d] = IloRangeArray(m_env, machineSlots);
+        for (int i = 0; i < machineSlots; ++i)
+        {
+            m_capacity[d][i] = IloRange(m_env, -IloInfinity, 0);
+        }
+        m_model.add(m_capacity[d]);
+    }
+
+    // Constraint 3: Link PM activation to each request assignment, tighter than one Big-M row per PM
+    m_newcomerLinks = IloArray<IloRangeArray>(m_env, newcomerSlots);
+    for (int j = 0; j < newcomerSlots; ++j)
+    {
+        m_newcomerLinks[j] = IloRangeArray(m_env, machineSlots);
+        for (int i = 0; i < machineSlots; ++i)
+        {
+            m_newcomerLinks[j][i] = IloRange(m_env, -IloInfinity, m_xNewcomers[j][i] - m_y[i], 0);
+        }
+        m_model.add(m_newcomerLinks[j]);
+    }
+
+    m_migrationLinks = IloArray<IloRangeArray>(m_env, migrationSlots);
+    for (int j = 0; j < migrationSlots; ++j)
+    {
+        m_migrationLinks[j] = IloRangeArray(m_env, machineSlots);
+        for (int i = 0; i < machineSlots; ++i)
+        {
+            m_migrationLinks[j][i] = IloRange(m_env, -IloInfinity, m_xMigrations[j][i] - m_y[i], 0);
+        }
+        m_model.add(m_migrationLinks[j]);
+    }
+
+    // Constraint 4: for each migration request should be migrated to 1 PM or not migrate
+    m_migrationAssignment = IloRangeArray(m_env, migrationSlots);
+    for (int j = 0; j < migrationSlots; ++j)
+    {
+        IloExpr sum(m_env);
+        for (int i = 0; i < machineSlots; ++i)
+        {
+            sum += m_xMigrations[j][i];
+        }
+        m_migrationAssignment[j] = IloRange(m_env, 0, sum - m_migrate[j], 0);
+        sum.end();
+    }
+    m_model.add(m_migrationAssignment);
+
+    // Constraint 5: TAM, written per bundle as -sum(ceil(cpu) * migrate) <= Tau * capacity - sum(ceil(cpu))
+    m_targetUtilization = IloRange(m_env, -IloInfinity, 0);
+    m_model.add(m_targetUtilization);
+
+    m_cplex = IloCplex(m_model);
+    m_cplex.use(CancelCallback(m_env, &m_cancel));
+    m_cplex.setOut(m_env.getNullStream());
+
+    m_machineSlots = machineSlots;
+    m_newcomerSlots = newcomerSlots;
+    m_migrationSlots = migrationSlots;
+    m_usedMachines = 0;
+    m_usedNewcomers = 0;
+    m_usedMigrations = 0;
+    m_assignmentReleased.assign(newcomerSlots, 0);
+    m_newcomerReleased.assign(size_t(newcomerSlots) * machineSlots, 0);
+    m_migrationReleased.assign(size_t(migrationSlots) * machineSlots, 0);
+}
+
+void ILPModel::update(const std::vector<const PhysicalMachine *> &machines, int I, const std::vector<VirtualMachine *> &newRequests, const std::vector<VirtualMachine *> &toMigrate, const ILPParameters &parameters)
+{
+    int J = newRequests.size();
+    int nMig = toMigrate.size();
+
+    // Free capacities, as in the capacity rows
+    std::vector<Resources> freeResources(I);
+    for (int i = 0; i < I; ++i)
+    {
+        freeResources[i] = machines[i]->getFreeResources();
+        freeResources[i].cpu = std::max(0.0, freeResources[i].cpu);
+    }
+
+    // Release the pairs the PM can host and fix the others, touching only the bounds that change
+    size_t released = 0;
+    for (int j = 0; j < std::max(J, m_usedNewcomers); ++j)
+    {
+        char placeable = 0;
+        for (int i = 0; i < std::max(I, m_usedMachines); ++i)
+        {
+            char open = j < J && i < I && canHost(newRequests[j]->getUsage(), freeResources[i]);
+            char &wasOpen = m_newcomerReleased[size_t(j) * m_machineSlots + i];
+            if (open != wasOpen)
+            {
+                m_xNewcomers[j][i].setUB(open);
+                wasOpen = open;
+            }
+            placeable |= open;
+            released += open;
+        }
+
+        // A request no PM can host is left unassigned instead of making the bundle infeasible
+        if (placeable != m_assignmentReleased[j])
+        {
+            m_assignment[j].setBounds(placeable, placeable);
+            m_assignmentReleased[j] = placeable;
+        }
+    }
+    for (int j = 0; j < std::max(nMig, m_usedMigrations); ++j)
+    {
+        for (int i = 0; i < std::max(I, m_usedMachines); ++i)
+        {
+            char open = j < nMig && i < I && canHost(toMigrate[j]->getUsage(), freeResources[i]);
+            char &wasOpen = m_migrationReleased[size_t(j) * m_machineSlots + i];
+            if (open != wasOpen)
+            {
+                m_xMigrations[j][i].setUB(open);
+                wasOpen = open;
+            }
+            released += open;
+        }
+        if ((j < nMig) != (j < m_usedMigrations))
+            m_migrate[j].setUB(j < nMig ? 1 : 0);
+    }
+
+    LogManager::instance().log(LogCategory::DEBUG, "ILPModel: " + std::to_string(released) + " of " + std::to_string(size_t(I) * (J + nMig)) + " assignment pairs fit their PM");
+
+    for (int i = std::min(I, m_usedMachines); i < std::max(I, m_usedMachines); ++i)
+    {
+        m_y[i].setUB(i < I ? 1 : 0);
+        if (i >= I)
+        {
+            // A released PM must not keep a capacity the empty slot cannot meet
+            for (int d = 0; d < DIMENSIONS; ++d)
+            {
+                m_capacity[d][i].setUB(IloInfinity);
+            }
+        }
+    }
+
+    m_usedMachines = I;
+    m_usedNewcomers = J;
+    m_usedMigrations = nMig;
+
+    // Pairs fixed to 0 keep their stale coefficients, they cannot contribute
+    for (int i = 0; i < I; ++i)
+    {
+        const PhysicalMachine &machine = *machines[i];
+
+        // Cost 1: Turning on a PM cost
+        m_objective.setLinearCoef(m_y[i], machine.isTurnedOn() ? 1 : 100);
+
+        for (int d = 0; d < DIMENSIONS; ++d)
+        {
+            m_capacity[d][i].setUB(dimension(freeResources[i], d));
+        }
+
+        // Cost 3 and 4: dynamic cost depending on the PM utilization, and the request sizes in the capacity rows
+        for (int j = 0; j < J; ++j)
+        {
+            if (!m_newcomerReleased[size_t(j) * m_machineSlots + i])
+                continue;
+
+            Resources usage = newRequests[j]->getUsage();
+            m_objective.setLinearCoef(m_xNewcomers[j][i], utilizationCost(machine, newRequests[j]->getTotalRequestedResources().cpu) * parameters.beta);
+            for (int d = 0; d < DIMENSIONS; ++d)
+            {
+                m_capacity[d][i].setLinearCoef(m_xNewcomers[j][i], dimension(usage, d));
+            }
+        }
+        for (int j = 0; j < nMig; ++j)
+        {
+            if (!m_migrationReleased[size_t(j) * m_machineSlots + i])
+                continue;
+
+            Resources usage = toMigrate[j]->getUsage();
+            m_objective.setLinearCoef(m_xMigrations[j][i], utilizationCost(machine, usage.cpu) * parameters.gamma);
+            for (int d = 0; d < DIMENSIONS; ++d)
+            {
+                m_capacity[d][i].setLinearCoef(m_xMigrations[j][i], dimension(usage, d));
+            }
+        }
+    }
+
+    // Cost 2: Adding migration costs, and the TAM row
+    double remainingCPU = 0;
+    for (int j = 0; j < nMig; ++j)
+    {
+        double cpu = ceil(toMigrate[j]->getUsage().cpu);
+        remainingCPU += cpu;
+        m_objective.setLinearCoef(m_migrate[j], parameters.mu);
+        m_targetUtilization.setLinearCoef(m_migrate[j], -cpu);
+    }
+    double totalCPUCapacity = machines[0]->getTotal().cpu;
+    m_targetUtilization.setUB(parameters.tau * parameters.tamShare * totalCPUCapacity - remainingCPU);
+}
+
+void ILPModel::bestFit(const std::vector<const PhysicalMachine *> &machines, int I, const std::vector<VirtualMachine *> &newRequests, const std::vector<VirtualMachine *> &toMigrate,
+                       const ILPParameters &parameters, std::vector<int> &newcomerMachines, std::vector<int> &migrationMachines) const
+{
+    // Same capacities as the capacity rows of the model
+    std::vector<Resources> freeResources(I);
+    for (int i = 0; i < I; ++i)
+    {
+        freeResources[i] = machines[i]->getFreeResources();
+        freeResources[i].cpu = std::max(0.0, freeResources[i].cpu);
+    }
+
+    auto place = [&](const Resources &need, int excludedID)
+    {
+        int bestIdx = -1;
+        double bestLeftCPU = 1e9;
+        for (int i = 0; i < I; ++i)
+        {
+            if (machines[i]->getID() == excludedID || !canHost(need, freeResources[i]))
+                continue;
+
+            double leftover = freeResources[i].cpu - need.cpu;
+            if (leftover < bestLeftCPU)
+            {
+                bestLeftCPU = leftover;
+                bestIdx = i;
+            }
+        }
+        if (bestIdx >= 0)
+        {
+            freeResources[bestIdx] -= need;
+        }
+        return bestIdx;
+    };
+
+    auto byDescendingCPU = [](const std::vector<VirtualMachine *> &vms)
+    {
+        std::vector<int> order(vms.size());
+        for (size_t j = 0; j < vms.size(); ++j)
+            order[j] = j;
+        std::sort(order.begin(), order.end(), [&vms](int a, int b)
+                  { return vms[a]->getUsage().cpu > vms[b]->getUsage().cpu; });
+        return order;
+    };
+
+    newcomerMachines.assign(newRequests.size(), -1);
+    for (int j : byDescendingCPU(newRequests))
+    {
+        newcomerMachines[j] = place(newRequests[j]->getUsage(), -1);
+    }
+
+    // Migrate the largest requests until the TAM row holds, the rest stay
+    double remainingCPU = 0;
+    for (auto *vm : toMigrate)
+        remainingCPU += ceil(vm->getUsage().cpu);
+    double targetCPU = parameters.tau * parameters.tamShare * machines[0]->getTotal().cpu;
+
+    migrationMachines.assign(toMigrate.size(), -1);
+    for (int j : byDescendingCPU(toMigrate))
+    {
+        if (remainingCPU <= targetCPU)
+            break;
+
+        migrationMachines[j] = place(toMigrate[j]->getUsage(), toMigrate[j]->getPMID());
+        if (migrationMachines[j] >= 0)
+            remainingCPU -= ceil(toMigrate[j]->getUsage().cpu);
+    }
+}
+
+void ILPModel::setStart(int I, const std::vector<int> &newcomerMachines, const std::vector<int> &migrationMachines)
+{
+    if (m_cplex.getNMIPStarts() > 0)
+        m_cplex.deleteMIPStarts(0, m_cplex.getNMIPStarts());
+
+    bool complete = std::find(newcomerMachines.begin(), newcomerMachines.end(), -1) == newcomerMachines.end();
+
+    IloNumVarArray vars(m_env);
+    IloNumArray values(m_env);
+    std::vector<char> hosts(I, 0);
+
+    for (size_t j = 0; j < newcomerMachines.size(); ++j)
+    {
+        if (newcomerMachines[j] >= 0)
+            hosts[newcomerMachines[j]] = 1;
+
+        // A partial start only fixes the placed requests, CPLEX completes the rest
+        for (int i = 0; i < I; ++i)
+        {
+            if (complete || i == newcomerMachines[j])
+            {
+                vars.add(m_xNewcomers[j][i]);
+                values.add(i == newcomerMachines[j] ? 1 : 0);
+            }
+        }
+    }
+
+    for (size_t j = 0; j < migrationMachines.size(); ++j)
+    {
+        if (migrationMachines[j] >= 0)
+            hosts[migrationMachines[j]] = 1;
+
+        vars.add(m_migrate[j]);
+        values.add(migrationMachines[j] >= 0 ? 1 : 0);
+        for (int i = 0; i < I; ++i)
+        {
+            vars.add(m_xMigrations[j][i]);
+            values.add(i == migrationMachines[j] ? 1 : 0);
+        }
+    }
+
+    for (int i = 0; i < I; ++i)
+    {
+        if (complete || hosts[i])
+        {
+            vars.add(m_y[i]);
+            values.add(hosts[i]);
+        }
+    }
+
+    m_cplex.addMIPStart(vars, values, IloCplex::MIPStartAuto);
+    vars.end();
+    values.end();
+}
+
+ILPSolution ILPModel::solve(const std::vector<const PhysicalMachine *> &machines, const std::vector<VirtualMachine *> &newRequests, const std::vector<VirtualMachine *> &toMigrate, const ILPParameters &parameters)
+{
+    int I = machines.size();
+    int J = newRequests.size();
+    int nMig = toMigrate.size();
+
+    ILPSolution solution;
+    solution.newcomerMachines.assign(J, -1);
+    solution.migrationMachines.assign(nMig, -1);
+
+    if (I == 0)
+        return solution;
+
+    try
+    {
+        auto buildStart = std::chrono::steady_clock::now();
+
+        if (I > m_machineSlots || J > m_newcomerSlots || nMig > m_migrationSlots)
+        {
+            build(grow(m_machineSlots, I), grow(m_newcomerSlots, J), grow(m_migrationSlots, nMig));
+        }
+        update(machines, I, newRequests, toMigrate, parameters);
+
+        std::vector<int> newcomerStart, migrationStart;
+        bestFit(machines, I, newRequests, toMigrate, parameters, newcomerStart, migrationStart);
+        setStart(I, newcomerStart, migrationStart);
+
+        auto solveStart = std::chrono::steady_clock::now();
+        solution.buildSeconds = std::chrono::duration<double>(solveStart - buildStart).count();
+
+        m_cplex.setParam(IloCplex::Param::TimeLimit, parameters.timeLimit);
+        m_cplex.setParam(IloCplex::Param::MIP::Tolerances::MIPGap, parameters.gap);
+        m_cplex.setParam(IloCplex::Param::Threads, parameters.threads);
+        m_cplex.setParam(IloCplex::Param::MIP::Limits::Nodes, parameters.nodeLimit > 0 ? parameters.nodeLimit : m_cplex.getDefault(IloCplex::Param::MIP::Limits::Nodes));
+        m_cancel = parameters.cancel;
+        bool ok = m_cplex.solve();
+        m_cancel = nullptr;
+
+        solution.solveSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - solveStart).count();
+        solution.nodes = m_cplex.getNnodes();
+
+        if (!ok)
+        {
+            // CPLEX rejected the start and found nothing better in time, keep the heuristic placement
+            solution.cost = std::numeric_limits<double>::infinity();
+            solution.newcomerMachines = newcomerStart;
+            solution.migrationMachines = migrationStart;
+            return solution;
+        }
+
+        solution.feasible = true;
+        solution.cost = m_cplex.getObjValue();
+        solution.gap = m_cplex.getMIPRelativeGap();
+        solution.optimal = m_cplex.getCplexStatus() == IloCplex::Optimal || m_cplex.getCplexStatus() == IloCplex::OptimalTol;
+
+        for (int j = 0; j < J; ++j)
+        {
+            for (int i = 0; i < I; ++i)
+            {
+                if (m_cplex.getValue(m_xNewcomers[j][i]) > 0.5)
+                {
+                    solution.newcomerMachines[j] = i;
+                    break;
+                }
+            }
+        }
+
+        for (int j = 0; j < nMig; ++j)
+        {
+            if (m_cplex.getValue(m_migrate[j]) < 0.5)
+                continue;
+
+            for (int i = 0; i < I; ++i)
+            {
+                if (m_cplex.getValue(m_xMigrations[j][i]) > 0.5)
+                {
+                    solution.migrationMachines[j] = i;
+                    break;
+                }
+            }
+        }
+    }
+    catch (IloException &e)
+    {
+        throw std::runtime_error("ILP Error: " + std::string(e.getMessage()));
+    }
+
+    return solution;
+}
@@ -1,295 +1,287 @@
-#include <ilcplex/ilocplex.h>
 #include <QFormLayout>
 #include "strategies/ILPStrategy.h"
+#include "strategies/ILPModel.h"
 #include "logging/LogManager.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <thread>
 
-ILPStrategy::ILPStrategy() : m_Mu(250), m_Tau(0.85), m_Beta(1.0), m_Gamma(1.0), m_MST(0.9), m_extraMachineCoefficient(5.0), m_maximumRequestsInPM(100e3), m_bundleSize(10)
+namespace
 {
-    m_chosenMachines.resize(1e3, nullptr);
-    m_chosenMachineCount = 0;
-    m_turnedOffMachines.resize(1e3, nullptr);
+    // Deals the items in the given order over k groups as 0..k-1, k-1..0, ... so each group gets a similar profile
+    std::vector<int> dealSnake(const std::vector<int> &order, int k)
+    {
+        std::vector<int> group(order.size());
+        for (size_t p = 0; p < order.size(); ++p)
+        {
+            int round = p / k;
+            int position = p % k;
+            group[order[p]] = (round % 2 == 0) ? position : k - 1 - position;
+        }
+        return group;
+    }
+
+    template <typename Key>
+    std::vector<int> descendingOrder(size_t count, Key key)
+    {
+        std::vector<int> order(count);
+        for (size_t i = 0; i < count; ++i)
+            order[i] = i;
+        std::stable_sort(order.begin(), order.end(), [&key](int a, int b)
+                         { return key(a) > key(b); });
+        return order;
+    }
+}
+
+ILPStrategy::ILPStrategy() : m_Mu(250), m_Tau(0.85), m_Beta(1.0), m_Gamma(1.0), m_MST(0.9), m_extraMachineCoefficient(5.0), m_bundleSize(10)
+{
+    m_model = new ILPModel();
 }
 
 ILPStrategy::~ILPStrategy()
 {
+    delete m_model;
+    for (auto *model : m_subModels)
+    {
+        delete model;
+    }
 }
 
 Results ILPStrategy::run(const std::vector<VirtualMachine *> &newRequests, const std::vector<VirtualMachine *> &toMigrate, const std::vector<PhysicalMachine> &machines)
 {
+    return runBudgeted(newRequests, toMigrate, machines, PlacementBudget{});
+}
+
+Results ILPStrategy::runBudgeted(const std::vector<VirtualMachine *> &newRequests, const std::vector<VirtualMachine *> &toMigrate, const std::vector<PhysicalMachine> &machines, const PlacementBudget &budget)
+{
+    BudgetTracker tracker(budget);
     Results results;
     results.placementDecision.reserve(newRequests.size());
     results.migrationDecision.reserve(toMigrate.size());
 
-    ChooseMachines(const_cast<std::vector<PhysicalMachine> &>(machines), newRequests, toMigrate);
+    ChooseMachines(machines, newRequests, toMigrate);
 
-    int I = m_chosenMachineCount;
+    int I = m_chosenMachines.size();
     int J = newRequests.size();
     int nMig = toMigrate.size();
 
     LogManager::instance().log(LogCategory::DEBUG, "ILPStrategy: Running ILP with " + std::to_string(I) + " PMs, " + std::to_string(J) + " new requests, and " + std::to_string(nMig) + " migration requests");
 
-    // CPLEX model
-    IloEnv env;
-    try
+    // The budget replaces the default time limit, the operation budget counts branch and bound nodes
+    ILPParameters parameters{m_Mu, m_Tau, m_Beta, m_Gamma, std::clamp(tracker.remaining(), 0.0, m_timeLimit), m_gap};
+    parameters.nodeLimit = budget.operations;
+    parameters.cancel = budget.cancel;
+    ILPSolution solution;
+    if (m_subproblemCount > 1 && I >= m_subproblemCount && J + nMig >= 2 * m_subproblemCount)
+        solution = solveDecomposed(newRequests, toMigrate, parameters);
+    else
+        solution = m_model->solve(m_chosenMachines, newRequests, toMigrate, parameters);
+
+    m_lastCost = solution.cost;
+    m_lastFeasibility = solution.feasible;
+    m_lastBuildTime = solution.buildSeconds;
+    m_lastSolveTime = solution.solveSeconds;
+
+    LogManager::instance().log(LogCategory::DEBUG, "ILPStrategy: Model update took " + std::to_string(solution.buildSeconds) + " s, solve took " + std::to_string(solution.solveSeconds) + " s");
+
+    results.quality.objective = solution.cost;
+    results.quality.gap = solution.gap;
+    results.quality.iterations = solution.nodes;
+    results.quality.complete = solution.optimal;
+
+    // Output results
+    for (int j = 0; j < J; ++j)
     {
-        IloModel model(env);
-
-        // Decision variables
-
-        IloArray<IloBoolVarArray> x_newcomers(env, J); // Newcomer Requests to assign
-        for (int j = 0; j < J; ++j)
-        {
-            x_newcomers[j] = IloBoolVarArray(env, I);
-        }
-
-        IloArray<IloBoolVarArray> x_migrations(env, nMig); // Migration Requests to assign
-        for (int j = 0; j < nMig; ++j)
-        {
-            x_migrations[j] = IloBoolVarArray(env, I);
-        }
-
-        IloBoolVarArray y(env, I); // PM activation status
-        for (int i = 0; i < I; ++i)
-        {
-            y[i] = IloBoolVar(env); // PM is turned on or not
-        }
-
-        IloBoolVarArray migrate(env, nMig); // Indicates if migration request is actually migrated
-        for (int j = 0; j < nMig; ++j)
-        {
-            for (int i = 0; i < I; ++i)
-            {
-                x_migrations[j][i] = IloBoolVar(env);
-            }
-            migrate[j] = IloBoolVar(env);
-        }
-
-        // Calculation of CpuUtilPer for eaxh PM for Cost 3
-
-        // COST FUNCTION
-
-        IloExpr cost(env);
-        // Cost 1: Turning on a PM cost
-        for (int i = 0; i < I; ++i)
-        {
-            cost += y[i] * (m_chosenMachines[i]->isTurnedOn() ? 1 : 100);
-        }
-
-        // Cost 2: Adding migration costs
-        for (int j = 0; j < nMig; ++j)
-        {
-            cost += migrate[j] * m_Mu; // Additional cost for each migration
-        }
+        int i = solution.newcomerMachines[j];
+        results.placementDecision.push_back({newRequests[j], i >= 0 ? m_chosenMachines[i]->getID() : -1});
+    }
 
-        // Cost 3: Adding a dynamic cost depends on to PMs utilization for newcomer requests
-        for (int i = 0; i < I; ++i)
+    for (int j = 0; j < nMig; ++j)
+    {
+        int i = solution.migrationMachines[j];
+        if (i >= 0)
         {
-            // Calculate the CPU utilization dynamically (assuming current assignments are part of the model)
-            double nCPUUtilization = floor(((m_chosenMachines[i]->getFreeResources().cpu * -1.0) / m_chosenMachines[i]->getTotal().cpu) * 100.0 + 100);
-
-            for (int j = 0; j < J; ++j)
-            {
-                double additionalCost = 0;
-                if (nCPUUtilization < 45)
-                {
-                    additionalCost = m_chosenMachines[i]->getPowerConsumptionCPU() * (300 - 4 * nCPUUtilization) * newRequests[j]->getTotalRequestedResources().cpu;
-                }
-                else
-                {
-                    additionalCost = m_chosenMachines[i]->getPowerConsumptionCPU() * (4 * nCPUUtilization - 60) * newRequests[j]->getTotalRequestedResources().cpu;
-                }
-                cost += x_newcomers[j][i] * additionalCost * m_Beta;
-            }
+            results.migrationDecision.push_back({toMigrate[j], m_chosenMachines[i]->getID()});
         }
+    }
 
-        // Cost 4: Adding a dynamic cost depends on to PMs utilization for migration requests
-        for (int i = 0; i < I; ++i)
-        {
-            // Calculate the CPU utilization dynamically (assuming current assignments are part of the model)
-            double nCPUUtilization = floor(((m_chosenMachines[i]->getFreeResources().cpu * -1.0) / m_chosenMachines[i]->getTotal().cpu) * 100.0 + 100);
-
-            for (int j = 0; j < nMig; ++j) // NOTE: Changed here (J to nMig)
-            {
-                double additionalCost = 0;
-                if (nCPUUtilization < 45)
-                {
-                    additionalCost = m_chosenMachines[i]->getPowerConsumptionCPU() * (300 - 4 * nCPUUtilization) * toMigrate[j]->getUsage().cpu;
-                }
-                else
-                {
-                    additionalCost = m_chosenMachines[i]->getPowerConsumptionCPU() * (4 * nCPUUtilization - 60) * toMigrate[j]->getUsage().cpu;
-                }
-                cost += x_migrations[j][i] * additionalCost * m_Gamma;
-            }
-        }
+    results.quality.seconds = tracker.elapsed();
+    return results;
+}
 
-        model.add(IloMinimize(env, cost));
+ILPSolution ILPStrategy::solveDecomposed(const std::vector<VirtualMachine *> &newRequests, const std::vector<VirtualMachine *> &toMigrate, const ILPParameters &parameters)
+{
+    const int k = m_subproblemCount;
+    const int I = m_chosenMachines.size();
+    const int J = newRequests.size();
+    const int nMig = toMigrate.size();
+
+    // Partition by resource profile: PMs by free CPU and requests by CPU demand, dealt over the groups
+    std::vector<int> machineGroup = dealSnake(descendingOrder(I, [this](int i)
+                                                              { return m_chosenMachines[i]->getFreeResources().cpu; }),
+                                              k);
+    std::vector<int> newcomerGroup = dealSnake(descendingOrder(J, [&newRequests](int j)
+                                                               { return newRequests[j]->getUsage().cpu; }),
+                                               k);
+    std::vector<int> migrationGroup = dealSnake(descendingOrder(nMig, [&toMigrate](int j)
+                                                                { return toMigrate[j]->getUsage().cpu; }),
+                                                k);
+
+    struct Subproblem
+    {
+        std::vector<const PhysicalMachine *> machines;
+        std::vector<int> machineIndex; // into m_chosenMachines
+        std::vector<VirtualMachine *> newRequests;
+        std::vector<int> newcomerIndex;
+        std::vector<VirtualMachine *> toMigrate;
+        std::vector<int> migrationIndex;
+        ILPParameters parameters;
+        ILPSolution solution;
+        std::exception_ptr error;
+    };
+    std::vector<Subproblem> subproblems(k, Subproblem{{}, {}, {}, {}, {}, {}, parameters, {}, nullptr});
+
+    for (int i = 0; i < I; ++i)
+    {
+        subproblems[machineGroup[i]].machines.push_back(m_chosenMachines[i]);
+        subproblems[machineGroup[i]].machineIndex.push_back(i);
+    }
+    for (int j = 0; j < J; ++j)
+    {
+        subproblems[newcomerGroup[j]].newRequests.push_back(newRequests[j]);
+        subproblems[newcomerGroup[j]].newcomerIndex.push_back(j);
+    }
 
-        // CONSTRAINTS
+    // The TAM allowance is split in proportion to the migration load of each group
+    double totalMigrationCPU = 0;
+    std::vector<double> groupMigrationCPU(k, 0.0);
+    for (int j = 0; j < nMig; ++j)
+    {
+        subproblems[migrationGroup[j]].toMigrate.push_back(toMigrate[j]);
+        subproblems[migrationGroup[j]].migrationIndex.push_back(j);
+        groupMigrationCPU[migrationGroup[j]] += ceil(toMigrate[j]->getUsage().cpu);
+        totalMigrationCPU += ceil(toMigrate[j]->getUsage().cpu);
+    }
 
-        // Constraint 1: Each request can only be assigned to one PM
-        for (int j = 0; j < J; ++j)
-        {
-            IloExpr sum(env);
-            for (int i = 0; i < I; ++i)
-            {
-                sum += x_newcomers[j][i];
-            }
-            model.add(sum == 1); // NOTE: Changed here (== to <=)
-            // model.add(IloRange(env, 1, sum, 1, "AllocatedToOnePM"));
-            sum.end();
-        }
+    // Share the cores between the concurrent solves
+    int threadsPerSolve = std::max(1, int(std::thread::hardware_concurrency()) / k);
+    for (int g = 0; g < k; ++g)
+    {
+        subproblems[g].parameters.tamShare = totalMigrationCPU > 0 ? groupMigrationCPU[g] / totalMigrationCPU : 1.0;
+        subproblems[g].parameters.threads = threadsPerSolve;
+    }
 
-        // Constraint 2: Resource constraints using A1, A2, A3, A4, A5 matrices
-        for (int i = 0; i < I; ++i)
-        {
-            IloExpr sumCPU(env);
-            IloExpr sumMemory(env);
-            IloExpr sumDisk(env);
-            IloExpr sumBW(env);
-            IloExpr sumFPGA(env);
+    // Every subproblem keeps its own persistent model and CPLEX environment
+    while (m_subModels.size() < size_t(k))
+    {
+        m_subModels.push_back(new ILPModel());
+    }
 
-            for (int j = 0; j < J; ++j)
+    auto solveStart = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    workers.reserve(k);
+    for (int g = 0; g < k; ++g)
+    {
+        workers.emplace_back([this, g, &subproblems]()
+                             {
+            auto &sub = subproblems[g];
+            try
             {
-                Resources requestedResources = newRequests[j]->getUsage();
-                sumCPU += x_newcomers[j][i] * requestedResources.cpu;
-                sumMemory += x_newcomers[j][i] * requestedResources.ram;
-                sumDisk += x_newcomers[j][i] * requestedResources.disk;
-                sumBW += x_newcomers[j][i] * requestedResources.bandwidth;
-                sumFPGA += x_newcomers[j][i] * requestedResources.fpga;
+                sub.solution = m_subModels[g]->solve(sub.machines, sub.newRequests, sub.toMigrate, sub.parameters);
             }
-
-            for (int k = 0; k < nMig; ++k)
+            catch (...)
             {
-                Resources requestedResources = toMigrate[k]->getUsage();
-                sumCPU += x_migrations[k][i] * requestedResources.cpu;
-                sumMemory += x_migrations[k][i] * requestedResources.ram;
-                sumDisk += x_migrations[k][i] * requestedResources.disk;
-                sumBW += x_migrations[k][i] * requestedResources.bandwidth;
-                sumFPGA += x_migrations[k][i] * requestedResources.fpga;
-            }
+                sub.error = std::current_exception();
+            } });
+    }
+    for (auto &worker : workers)
+    {
+        worker.join();
+    }
+    double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - solveStart).count();
 
-            auto freeResources = m_chosenMachines[i]->getFreeResources();
-            model.add(sumCPU <= std::max(0.0, freeResources.cpu));
-            // cout << "sumCPU: " << sumCPU << "and A1[" << i << "][0] is " << A1[i][0] <<endl;
-            model.add(sumMemory <= freeResources.ram);
-            model.add(sumDisk <= freeResources.disk);
-            model.add(sumBW <= freeResources.bandwidth);
-            model.add(sumFPGA <= freeResources.fpga);
-
-            sumCPU.end();
-            sumMemory.end();
-            sumDisk.end();
-            sumBW.end();
-            sumFPGA.end();
-        }
+    for (auto &sub : subproblems)
+    {
+        if (sub.error)
+            std::rethrow_exception(sub.error);
+    }
 
-        // Constraint 3: Link PM activation to request assignment using the Big-M method
-        for (int i = 0; i < I; ++i)
-        {
-            IloExpr sum(env);
-            // Sum up assignment variables for newcomer requests
-            for (int j = 0; j < J; ++j)
-            {
-                sum += x_newcomers[j][i];
-            }
-            // Sum up assignment variables for migration requests
-            for (int j = 0; j < nMig; ++j)
-            {
-                sum += x_migrations[j][i];
-            }
-            // Ensure the PM is turned on if it has any requests assigned to it
-            model.add(sum <= m_maximumRequestsInPM * y[i]); // If any request is assigned, PM must be on
-            sum.end();
-        }
+    // Merge, the groups own disjoint PMs so their decisions never compete for capacity
+    // The gap of the merged placement is unknown, each group only bounds its own part
+    ILPSolution solution;
+    solution.feasible = true;
+    solution.optimal = true;
+    solution.newcomerMachines.assign(J, -1);
+    solution.migrationMachines.assign(nMig, -1);
+    for (auto &sub : subproblems)
+    {
+        solution.feasible = solution.feasible && sub.solution.feasible;
+        solution.optimal = solution.optimal && sub.solution.optimal;
+        solution.cost += sub.solution.cost;
+        solution.nodes += sub.solution.nodes;
+        solution.buildSeconds = std::max(solution.buildSeconds, sub.solution.buildSeconds);
 
-        // Constraint 4: for each migration request should be migrated to 1 PM or not migrate
-        for (int j = 0; j < nMig; ++j)
+        for (size_t j = 0; j < sub.newcomerIndex.size(); ++j)
         {
-            IloExpr sumMigrationAssignments(env);
-            for (int i = 0; i < I; ++i)
-            {
-                sumMigrationAssignments += x_migrations[j][i];
-            }
-            model.add(sumMigrationAssignments == migrate[j]); // Linking migration decision to the assignment of PMs
-            sumMigrationAssignments.end();
+            int i = sub.solution.newcomerMachines[j];
+            solution.newcomerMachines[sub.newcomerIndex[j]] = i >= 0 ? sub.machineIndex[i] : -1;
         }
-
-        // Constraint 5: It is the constraint about how much load we need to migrate according to the TAM value defined in my thesis
-        IloExpr remainingCPU(env);
-        for (int j = 0; j < nMig; ++j)
+        for (size_t j = 0; j < sub.migrationIndex.size(); ++j)
         {
-            remainingCPU += (1 - migrate[j]) * ceil(toMigrate[j]->getUsage().cpu); // CPU load of non-migrated requests
+            int i = sub.solution.migrationMachines[j];
+            solution.migrationMachines[sub.migrationIndex[j]] = i >= 0 ? sub.machineIndex[i] : -1;
         }
-        double totalCPUCapacity = m_chosenMachines[0]->getTotal().cpu; // Assuming PMq is defined and nTotalCPU is its total CPU capacity
-        // TODO: violatedPM
-
-        // cout << "*********The CPU target after Allcation is:  " << Tau * stpPM_Array[violatedPM].nTotalCPU << endl;
-        model.add(remainingCPU <= m_Tau * totalCPUCapacity); // Constraint to keep remaining load within threshold
-        remainingCPU.end();
-
-        //  SOLVE THE ILP
+    }
+    solution.solveSeconds = wallSeconds;
 
-        IloCplex cplex(model);
-        cplex.setParam(IloCplex::Param::TimeLimit, 60.0);
-        // cplex.setParam(IloCplex::Param::Parallel, IloCplex::Parallel_Mode::Opportunistic);
-        cplex.setOut(env.getNullStream());
-        bool ok = cplex.solve();
+    // Conflict pass: requests their group could not host go best fit on what every group left free
+    std::vector<Resources> freeResources(I);
+    for (int i = 0; i < I; ++i)
+    {
+        freeResources[i] = m_chosenMachines[i]->getFreeResources();
+    }
+    for (int j = 0; j < J; ++j)
+    {
+        if (solution.newcomerMachines[j] >= 0)
+            freeResources[solution.newcomerMachines[j]] -= newRequests[j]->getUsage();
+    }
+    for (int j = 0; j < nMig; ++j)
+    {
+        if (solution.migrationMachines[j] >= 0)
+            freeResources[solution.migrationMachines[j]] -= toMigrate[j]->getUsage();
+    }
 
-        if (ok)
-        {
-            m_lastCost = cplex.getObjValue();
-            m_lastFeasibility = true;
-        }
-        else
-        {
-            m_lastCost = std::numeric_limits<double>::infinity();
-            m_lastFeasibility = false;
-        }
+    size_t resolved = 0;
+    for (int j : descendingOrder(J, [&newRequests](int j)
+                                 { return newRequests[j]->getUsage().cpu; }))
+    {
+        if (solution.newcomerMachines[j] >= 0)
+            continue;
 
-        // Output results
-        for (int j = 0; j < J; ++j)
+        Resources need = newRequests[j]->getUsage();
+        int bestIdx = -1;
+        double bestLeftCPU = 1e9;
+        for (int i = 0; i < I; ++i)
         {
-            bool assigned = false;
-            for (int i = 0; i < I; ++i)
-            {
-                if (cplex.getValue(x_newcomers[j][i]) > 0.5)
-                {
-                    results.placementDecision.push_back({newRequests[j], m_chosenMachines[i]->getID()});
-                    assigned = true;
-                    break;
-                }
-            }
-            if (!assigned)
+            if (canHost(need, freeResources[i]) && freeResources[i].cpu - need.cpu < bestLeftCPU)
             {
-                results.placementDecision.push_back({newRequests[j], -1});
+                bestLeftCPU = freeResources[i].cpu - need.cpu;
+                bestIdx = i;
             }
         }
-
-        for (int j = 0; j < nMig; ++j)
+        if (bestIdx >= 0)
         {
-            if (cplex.getValue(migrate[j]) > 0.5)
-            {
-                for (int i = 0; i < I; ++i)
-                {
-                    if (cplex.getValue(x_migrations[j][i]) > 0.5)
-                    {
-                        results.migrationDecision.push_back({toMigrate[j], m_chosenMachines[i]->getID()});
-                    }
-                }
-            }
+            freeResources[bestIdx] -= need;
+            solution.newcomerMachines[j] = bestIdx;
+            resolved++;
         }
-
-        cplex.clear();
-    }
-    catch (IloException &e)
-    {
-        throw std::runtime_error("ILP Error: " + std::string(e.getMessage()));
     }
 
-    env.end();
+    LogManager::instance().log(LogCategory::DEBUG, "ILPStrategy: Solved " + std::to_string(k) + " subproblems in " + std::to_string(wallSeconds) + " s, conflict pass placed " + std::to_string(resolved) + " requests");
 
-    return results;
+    return solution;
 }
 
 double ILPStrategy::getMigrationThreshold()
@@ -302,42 +294,16 @@ size_t ILPStrategy::getBundleSize()
     return m_bundleSize;
 }
 
-void ILPStrategy::ChooseMachines(std::vector<PhysicalMachine> &machines, const std::vector<VirtualMachine *> &requests, const std::vector<VirtualMachine *> &migrations)
+void ILPStrategy::ChooseMachines(const std::vector<PhysicalMachine> &machines, const std::vector<VirtualMachine *> &requests, const std::vector<VirtualMachine *> &migrations)
 {
-    m_chosenMachineCount = 0;
-
-    for (auto &machine : machines)
-    {
-        if (machine.isTurnedOn())
-        {
-            m_chosenMachines[m_chosenMachineCount++] = &machine;
-        }
-    }
-
-    size_t numExtraPMsToInclude = std::min(machines.size() - m_chosenMachineCount, static_cast<size_t>(m_extraMachineCoefficient * (requests.size() + migrations.size())));
-
-    // Find numExtraPMsToInclude turned off machines with the lowest power consumption and add them to the chosenMachines vector
-    size_t turnedOffMachineCount = 0;
-    for (auto &machine : machines)
-    {
-        if (!machine.isTurnedOn())
-        {
-            m_turnedOffMachines[turnedOffMachineCount++] = &machine;
-        }
-    }
-
-    std::sort(m_turnedOffMachines.begin(), m_turnedOffMachines.begin() + turnedOffMachineCount, [this](PhysicalMachine *a, PhysicalMachine *b)
-              { return CalculatePowerOnCost(*a) < CalculatePowerOnCost(*b); });
-
-    for (size_t i = 0; i < numExtraPMsToInclude; ++i)
-    {
-        m_chosenMachines[m_chosenMachineCount++] = m_turnedOffMachines[i];
-    }
-}
-
-double ILPStrategy::CalculatePowerOnCost(PhysicalMachine &machine)
-{
-    return machine.getPowerOnCost() + machine.getPowerConsumptionCPU() * 4.0 + machine.getPowerConsumptionFPGA() * 2.0;
+    std::vector<VirtualMachine *> bundle;
+    bundle.reserve(requests.size() + migrations.size());
+    bundle.insert(bundle.end(), requests.begin(), requests.end());
+    bundle.insert(bundle.end(), migrations.begin(), migrations.end());
+
+    m_candidateSelector.setExtraMachineCoefficient(m_extraMachineCoefficient);
+    m_candidateSelector.setMaxTurnedOnCandidates(m_maxTurnedOnCandidates);
+    m_chosenMachines = m_candidateSelector.select(bundle, machines);
 }
 
 QWidget *ILPStrategy::createConfigWidget(QWidget *parent)
@@ -389,11 +355,23 @@ QWidget *ILPStrategy::createConfigWidget(QWidget *parent)
         m_extraMachineCoefficientSpin->setValue(m_extraMachineCoefficient);
         layout->addRow("Extra Machine Coefficient:", m_extraMachineCoefficientSpin);
 
-        m_maximumRequestsInPMSpin = new QSpinBox(m_configWidget);
-        m_maximumRequestsInPMSpin->setMinimum(1);
-        m_maximumRequestsInPMSpin->setMaximum(2e5);
-        m_maximumRequestsInPMSpin->setValue(m_maximumRequestsInPM);
-        layout->addRow("Maximum Requests in PM:", m_maximumRequestsInPMSpin);
+        m_maxTurnedOnCandidatesSpin = new QSpinBox(m_configWidget);
+        m_maxTurnedOnCandidatesSpin->setRange(0, 100000);
+        m_maxTurnedOnCandidatesSpin->setSpecialValueText("All");
+        m_maxTurnedOnCandidatesSpin->setValue(m_maxTurnedOnCandidates);
+        layout->addRow("Max Turned On Candidates:", m_maxTurnedOnCandidatesSpin);
+
+        m_gapSpin = new QDoubleSpinBox(m_configWidget);
+        m_gapSpin->setDecimals(4);
+        m_gapSpin->setRange(0.0, 1.0);
+        m_gapSpin->setSingleStep(0.001);
+        m_gapSpin->setValue(m_gap);
+        layout->addRow("MIP Gap:", m_gapSpin);
+
+        m_subproblemCountSpin = new QSpinBox(m_configWidget);
+        m_subproblemCountSpin->setRange(1, 64);
+        m_subproblemCountSpin->setValue(m_subproblemCount);
+        layout->addRow("Subproblems (1 = monolithic):", m_subproblemCountSpin);
 
         m_configWidget->setLayout(layout);
     }
@@ -409,7 +387,9 @@ void ILPStrategy::applyConfigFromUI()
     m_Gamma = m_GammaSpin->value();
     m_MST = m_MSTSpin->value();
     m_extraMachineCoefficient = m_extraMachineCoefficientSpin->value();
-    m_maximumRequestsInPM = m_maximumRequestsInPMSpin->value();
+    m_maxTurnedOnCandidates = m_maxTurnedOnCandidatesSpin->value();
+    m_gap = m_gapSpin->value();
+    m_subproblemCount = m_subproblemCountSpin->value();
 }
 
 QString ILPStrategy::name() const
@@ -417,6 +397,23 @@ QString ILPStrategy::name() const
     return "ILP Strategy";
 }
 
+IPlacementStrategy *ILPStrategy::clone() const
+{
+    auto *copy = new ILPStrategy();
+    copy->m_Mu = m_Mu;
+    copy->m_Tau = m_Tau;
+    copy->m_Beta = m_Beta;
+    copy->m_Gamma = m_Gamma;
+    copy->m_MST = m_MST;
+    copy->m_extraMachineCoefficient = m_extraMachineCoefficient;
+    copy->m_maxTurnedOnCandidates = m_maxTurnedOnCandidates;
+    copy->m_gap = m_gap;
+    copy->m_timeLimit = m_timeLimit;
+    copy->m_subproblemCount = m_subproblemCount;
+    copy->m_bundleSize = m_bundleSize;
+    return copy;
+}
+
 QWidget *ILPStrategy::createStatusWidget(QWidget *parent)
 {
     if (!m_statusWidget)
@@ -442,8 +439,14 @@ QWidget *ILPStrategy::createStatusWidget(QWidget *parent)
         auto extraMachineCoefficientLabel = new QLabel(QString::number(m_extraMachineCoefficient), m_statusWidget);
         layout->addRow("Extra Machine Coefficient:", extraMachineCoefficientLabel);
 
-        auto maximumRequestsInPMLabel = new QLabel(QString::number(m_maximumRequestsInPM), m_statusWidget);
-        layout->addRow("Maximum Requests in PM:", maximumRequestsInPMLabel);
+        auto maxTurnedOnCandidatesLabel = new QLabel(m_maxTurnedOnCandidates > 0 ? QString::number(m_maxTurnedOnCandidates) : "All", m_statusWidget);
+        layout->addRow("Max Turned On Candidates:", maxTurnedOnCandidatesLabel);
+
+        auto gapLabel = new QLabel(QString::number(m_gap), m_statusWidget);
+        layout->addRow("MIP Gap:", gapLabel);
+
+        auto subproblemCountLabel = new QLabel(QString::number(m_subproblemCount), m_statusWidget);
+        layout->addRow("Subproblems (1 = monolithic):", subproblemCountLabel);
 
         m_statusWidget->setLayout(layout);
     }
@@ -0,0 +1,616 @@
+#include "strategies/LagrangianStrategy.h"
+#include "strategies/UtilizationCost.h"
+#include "logging/LogManager.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <QFormLayout>
+#include <QLabel>
+
+namespace
+{
+    // Share of the PM capacity, so the multipliers of every dimension live on the same scale
+    Resources share(const Resources &r, const Resources &total)
+    {
+        auto part = [](double value, double capacity)
+        {
+            return capacity > 0 ? value / capacity : 0.0;
+        };
+        return Resources(part(r.cpu, total.cpu), part(r.ram, total.ram), part(r.disk, total.disk), part(r.bandwidth, total.bandwidth), part(r.fpga, total.fpga));
+    }
+
+    double dot(const Resources &a, const Resources &b)
+    {
+        return a.cpu * b.cpu + a.ram * b.ram + a.disk * b.disk + a.bandwidth * b.bandwidth + a.fpga * b.fpga;
+    }
+
+    Resources projectedStep(const Resources &multiplier, const Resources &gradient, double step)
+    {
+        return Resources(std::max(0.0, multiplier.cpu + step * gradient.cpu), std::max(0.0, multiplier.ram + step * gradient.ram),
+                         std::max(0.0, multiplier.disk + step * gradient.disk), std::max(0.0, multiplier.bandwidth + step * gradient.bandwidth),
+                         std::max(0.0, multiplier.fpga + step * gradient.fpga));
+    }
+}
+
+LagrangianStrategy::LagrangianStrategy()
+{
+}
+
+LagrangianStrategy::~LagrangianStrategy()
+{
+}
+
+Results LagrangianStrategy::run(const std::vector<VirtualMachine *> &newRequests, const std::vector<VirtualMachine *> &toMigrate, const std::vector<PhysicalMachine> &machines)
+{
+    return runBudgeted(newRequests, toMigrate, machines, PlacementBudget{});
+}
+
+Results LagrangianStrategy::runBudgeted(const std::vector<VirtualMachine *> &newRequests, const std::vector<VirtualMachine *> &toMigrate, const std::vector<PhysicalMachine> &machines, const PlacementBudget &budget)
+{
+    BudgetTracker tracker(budget);
+
+    Results results;
+    results.placementDecision.reserve(newRequests.size());
+    results.migrationDecision.reserve(toMigrate.size());
+
+    std::vector<VirtualMachine *> bundle;
+    bundle.reserve(newRequests.size() + toMigrate.size());
+    bundle.insert(bundle.end(), newRequests.begin(), newRequests.end());
+    bundle.insert(bundle.end(), toMigrate.begin(), toMigrate.end());
+
+    m_candidateSelector.setExtraMachineCoefficient(m_extraMachineCoefficient);
+    m_candidateSelector.setMaxTurnedOnCandidates(m_maxTurnedOnCandidates);
+    m_chosenMachines = m_candidateSelector.select(bundle, machines);
+
+    if (m_chosenMachines.empty())
+    {
+        for (auto *vm : newRequests)
+            results.placementDecision.push_back({vm, -1});
+        return results;
+    }
+
+    prepare(newRequests, toMigrate);
+
+    int I = m_chosenMachines.size();
+    m_multipliers.assign(I, Resources());
+
+    Placement best{std::vector<int>(m_requests.size(), -1), std::numeric_limits<double>::infinity()};
+    double bestBound = -std::numeric_limits<double>::infinity();
+    double step = m_initialStep;
+    int stall = 0;
+    int iteration = 0;
+
+    // The first rounding always runs, so a spent budget still returns a placement
+    std::vector<int> choice;
+    std::vector<Resources> load;
+    bool converged = false;
+    for (; iteration < m_maxIterations && (iteration == 0 || !tracker.exhausted(iteration)); ++iteration)
+    {
+        double bound = relax(choice, load);
+
+        Placement rounded = round(choice);
+        if (rounded.cost < best.cost)
+            best = rounded;
+
+        if (bound > bestBound + 1e-9)
+        {
+            bestBound = bound;
+            stall = 0;
+        }
+        else if (++stall >= m_stallIterations)
+        {
+            step /= 2;
+            stall = 0;
+        }
+
+        if (best.cost - bestBound <= m_gap * std::max(std::abs(best.cost), 1.0))
+        {
+            converged = true;
+            break;
+        }
+
+        // Capacity violation of the relaxed choices
+        std::vector<Resources> gradient(I);
+        double norm = 0;
+        for (int i = 0; i < I; ++i)
+        {
+            gradient[i] = share(load[i] - m_free[i], m_chosenMachines[i]->getTotal());
+            norm += dot(gradient[i], gradient[i]);
+        }
+        if (norm <= 0)
+        {
+            converged = true;
+            break;
+        }
+
+        // Polyak step towards the best placement found so far
+        double t = step * (best.cost - bound) / norm;
+        for (int i = 0; i < I; ++i)
+        {
+            m_multipliers[i] = projectedStep(m_multipliers[i], gradient[i], t);
+        }
+    }
+
+    m_lastCost = best.cost;
+    m_lastBound = bestBound;
+    m_lastIterations = iteration;
+
+    results.quality.objective = best.cost;
+    results.quality.gap = (best.cost - bestBound) / std::max(std::abs(best.cost), 1.0);
+    results.quality.iterations = iteration;
+    results.quality.complete = converged || iteration >= m_maxIterations;
+
+    for (int j = 0; j < m_newcomerCount; ++j)
+    {
+        int i = best.machine[j];
+        results.placementDecision.push_back({newRequests[j], i >= 0 ? m_chosenMachines[i]->getID() : -1});
+    }
+    for (size_t j = 0; j < toMigrate.size(); ++j)
+    {
+        int i = best.machine[m_newcomerCount + j];
+        if (i >= 0)
+        {
+            results.migrationDecision.push_back({toMigrate[j], m_chosenMachines[i]->getID()});
+        }
+    }
+
+    results.quality.seconds = tracker.elapsed();
+    LogManager::instance().log(LogCategory::DEBUG, "LagrangianStrategy: Cost " + std::to_string(best.cost) + ", bound " + std::to_string(bestBound) + " after " + std::to_string(iteration) + " iterations in " + std::to_string(results.quality.seconds) + " s");
+
+    return results;
+}
+
+void LagrangianStrategy::prepare(const std::vector<VirtualMachine *> &newRequests, const std::vector<VirtualMachine *> &toMigrate)
+{
+    int I = m_chosenMachines.size();
+
+    m_free.resize(I);
+    m_powerOnCost.resize(I);
+    m_unitCPUCost.resize(I);
+    for (int i = 0; i < I; ++i)
+    {
+        const PhysicalMachine &machine = *m_chosenMachines[i];
+        m_free[i] = machine.getFreeResources();
+        m_free[i].cpu = std::max(0.0, m_free[i].cpu);
+        m_powerOnCost[i] = machine.isTurnedOn() ? 1 : 100;
+        m_unitCPUCost[i] = utilizationCost(machine, 1.0);
+    }
+
+    m_newcomerCount = newRequests.size();
+    m_requests.clear();
+    m_requests.reserve(newRequests.size() + toMigrate.size());
+
+    for (auto *vm : newRequests)
+    {
+        Request request{vm->getUsage(), vm->getTotalRequestedResources().cpu, m_Beta, 0.0, {}};
+        for (int i = 0; i < I; ++i)
+        {
+            if (canHost(request.usage, m_free[i]))
+                request.candidates.push_back(i);
+        }
+        m_requests.push_back(std::move(request));
+    }
+
+    double remainingCPU = 0;
+    for (auto *vm : toMigrate)
+    {
+        Request request{vm->getUsage(), vm->getUsage().cpu, m_Gamma, ceil(vm->getUsage().cpu), {}};
+        remainingCPU += request.tamCPU;
+        for (int i = 0; i < I; ++i)
+        {
+            if (m_chosenMachines[i]->getID() != vm->getPMID() && canHost(request.usage, m_free[i]))
+                request.candidates.push_back(i);
+        }
+        m_requests.push_back(std::move(request));
+    }
+
+    // TAM: the load left on the overcommitted PM must come down to tau of its capacity
+    m_tamExcess = remainingCPU - m_Tau * m_chosenMachines[0]->getTotal().cpu;
+}
+
+double LagrangianStrategy::reducedCost(int j, int i) const
+{
+    const Request &request = m_requests[j];
+    return m_unitCPUCost[i] * request.cpuCost * request.scaler + dot(m_multipliers[i], share(request.usage, m_chosenMachines[i]->getTotal()));
+}
+
+double LagrangianStrategy::relax(std::vector<int> &choice, std::vector<Resources> &load) const
+{
+    int I = m_chosenMachines.size();
+    int total = m_requests.size();
+
+    choice.assign(total, -1);
+    load.assign(I, Resources());
+
+    // Dropping the x <= y rows keeps the bound valid, the power on costs are not negative
+    double bound = 0;
+    for (int i = 0; i < I; ++i)
+    {
+        bound -= dot(m_multipliers[i], share(m_free[i], m_chosenMachines[i]->getTotal()));
+    }
+
+    std::vector<double> cost(total, 0.0);
+    for (int j = 0; j < total; ++j)
+    {
+        double bestCost = std::numeric_limits<double>::infinity();
+        for (int i : m_requests[j].candidates)
+        {
+            double c = reducedCost(j, i);
+            if (c < bestCost)
+            {
+                bestCost = c;
+                choice[j] = i;
+            }
+        }
+        cost[j] = bestCost;
+    }
+
+    // Newcomers always take their cheapest PM
+    for (int j = 0; j < m_newcomerCount; ++j)
+    {
+        if (choice[j] < 0)
+            continue;
+
+        bound += cost[j];
+        load[choice[j]] += m_requests[j].usage;
+    }
+
+    // Migrations cover the TAM excess as a fractional knapsack, cheapest per migrated core first
+    std::vector<int> order;
+    for (int j = m_newcomerCount; j < total; ++j)
+    {
+        if (choice[j] >= 0 && m_requests[j].tamCPU > 0)
+            order.push_back(j);
+    }
+    std::sort(order.begin(), order.end(), [this, &cost](int a, int b)
+              { return (m_Mu + cost[a]) / m_requests[a].tamCPU < (m_Mu + cost[b]) / m_requests[b].tamCPU; });
+
+    std::vector<int> migrated(total, 0);
+    double excess = m_tamExcess;
+    for (int j : order)
+    {
+        if (excess <= 0)
+            break;
+
+        double fraction = std::min(1.0, excess / m_requests[j].tamCPU);
+        bound += (m_Mu + cost[j]) * fraction;
+        excess -= m_requests[j].tamCPU;
+        load[choice[j]] += m_requests[j].usage;
+        migrated[j] = 1;
+    }
+    for (int j = m_newcomerCount; j < total; ++j)
+    {
+        if (!migrated[j])
+            choice[j] = -1;
+    }
+
+    return bound;
+}
+
+LagrangianStrategy::Placement LagrangianStrategy::round(const std::vector<int> &choice) const
+{
+    int I = m_chosenMachines.size();
+    int total = m_requests.size();
+
+    Placement placement{std::vector<int>(total, -1), 0.0};
+    std::vector<Resources> residual = m_free;
+    std::vector<int> hosted(I, 0);
+
+    // Keep the relaxed PM when it still fits, otherwise the cheapest PM that does, power on included
+    auto place = [&](int j, int preferred)
+    {
+        const Resources &usage = m_requests[j].usage;
+        int target = -1;
+        if (preferred >= 0 && canHost(usage, residual[preferred]))
+        {
+            target = preferred;
+        }
+        else
+        {
+            double bestCost = std::numeric_limits<double>::infinity();
+            for (int i : m_requests[j].candidates)
+            {
+                if (!canHost(usage, residual[i]))
+                    continue;
+
+                double c = reducedCost(j, i) + (hosted[i] ? 0 : m_powerOnCost[i]);
+                if (c < bestCost)
+                {
+                    bestCost = c;
+                    target = i;
+                }
+            }
+        }
+        if (target >= 0)
+        {
+            residual[target] -= usage;
+            hosted[target]++;
+            placement.machine[j] = target;
+        }
+        return target;
+    };
+
+    std::vector<int> order(total);
+    for (int j = 0; j < total; ++j)
+        order[j] = j;
+    std::sort(order.begin(), order.end(), [this](int a, int b)
+              { return m_requests[a].usage.cpu > m_requests[b].usage.cpu; });
+
+    double excess = m_tamExcess;
+    for (int j : order)
+    {
+        if (j < m_newcomerCount)
+        {
+            place(j, choice[j]);
+        }
+        else if (choice[j] >= 0 && place(j, choice[j]) >= 0)
+        {
+            excess -= m_requests[j].tamCPU;
+        }
+    }
+
+    // Migrations that did not fit are replaced by the largest remaining ones until the TAM row holds
+    for (int j : order)
+    {
+        if (excess <= 0)
+            break;
+        if (j < m_newcomerCount || placement.machine[j] >= 0)
+            continue;
+
+        if (place(j, -1) >= 0)
+            excess -= m_requests[j].tamCPU;
+    }
+
+    // Repair: empty PMs the placement turns on when their requests fit on PMs in use for less
+    for (int i = 0; i < I; ++i)
+    {
+        if (!hosted[i] || m_chosenMachines[i]->isTurnedOn())
+            continue;
+
+        std::vector<Resources> trial = residual;
+        std::vector<std::pair<int, int>> moves;
+        double delta = -m_powerOnCost[i];
+        bool movable = true;
+        for (int j = 0; j < total; ++j)
+        {
+            if (placement.machine[j] != i)
+                continue;
+
+            int target = -1;
+            double bestCost = std::numeric_limits<double>::infinity();
+            for (int k : m_requests[j].candidates)
+            {
+                if (k == i || !hosted[k] || !canHost(m_requests[j].usage, trial[k]))
+                    continue;
+
+                double c = m_unitCPUCost[k] * m_requests[j].cpuCost * m_requests[j].scaler;
+                if (c < bestCost)
+                {
+                    bestCost = c;
+                    target = k;
+                }
+            }
+            if (target < 0)
+            {
+                movable = false;
+                break;
+            }
+
+            trial[target] -= m_requests[j].usage;
+            delta += bestCost - m_unitCPUCost[i] * m_requests[j].cpuCost * m_requests[j].scaler;
+            moves.push_back({j, target});
+        }
+
+        if (movable && delta < 0)
+        {
+            for (auto &[j, target] : moves)
+            {
+                placement.machine[j] = target;
+                hosted[target]++;
+            }
+            residual = trial;
+            residual[i] = m_free[i];
+            hosted[i] = 0;
+        }
+    }
+
+    placement.cost = placementCost(placement.machine);
+
+    // A placement that leaves the TAM row violated only wins when nothing else is found
+    if (excess > 0)
+        placement.cost += m_Mu * excess;
+
+    return placement;
+}
+
+double LagrangianStrategy::placementCost(const std::vector<int> &machine) const
+{
+    std::vector<char> used(m_chosenMachines.size(), 0);
+    double cost = 0;
+    for (size_t j = 0; j < machine.size(); ++j)
+    {
+        int i = machine[j];
+        if (i < 0)
+            continue;
+
+        used[i] = 1;
+        cost += m_unitCPUCost[i] * m_requests[j].cpuCost * m_requests[j].scaler;
+        if (int(j) >= m_newcomerCount)
+            cost += m_Mu;
+    }
+    for (size_t i = 0; i < used.size(); ++i)
+    {
+        if (used[i])
+            cost += m_powerOnCost[i];
+    }
+    return cost;
+}
+
+double LagrangianStrategy::getMigrationThreshold()
+{
+    return m_MST;
+}
+
+size_t LagrangianStrategy::getBundleSize()
+{
+    return m_bundleSize;
+}
+
+QWidget *LagrangianStrategy::createConfigWidget(QWidget *parent)
+{
+    if (!m_configWidget)
+    {
+        m_configWidget = new QWidget(parent);
+        auto layout = new QFormLayout(m_configWidget);
+
+        m_MuSpin = new QDoubleSpinBox(m_configWidget);
+        m_MuSpin->setRange(0.0, 1000.0);
+        m_MuSpin->setSingleStep(1.0);
+        m_MuSpin->setValue(m_Mu);
+        layout->addRow("Mu (Migration Cost):", m_MuSpin);
+
+        m_TauSpin = new QDoubleSpinBox(m_configWidget);
+        m_TauSpin->setRange(0.0, 1.0);
+        m_TauSpin->setSingleStep(0.01);
+        m_TauSpin->setValue(m_Tau);
+        layout->addRow("Tau (Target Utilization after Migration):", m_TauSpin);
+
+        m_BetaSpin = new QDoubleSpinBox(m_configWidget);
+        m_BetaSpin->setRange(0.0, 100.0);
+        m_BetaSpin->setSingleStep(0.01);
+        m_BetaSpin->setValue(m_Beta);
+        layout->addRow("Beta (Expected Utilization Scaler for Newcomers):", m_BetaSpin);
+
+        m_GammaSpin = new QDoubleSpinBox(m_configWidget);
+        m_GammaSpin->setRange(0.0, 100.0);
+        m_GammaSpin->setSingleStep(0.01);
+        m_GammaSpin->setValue(m_Gamma);
+        layout->addRow("Gamma (Expected Utilization Scaler for Migrations):", m_GammaSpin);
+
+        m_MSTSpin = new QDoubleSpinBox(m_configWidget);
+        m_MSTSpin->setRange(0.0, 1.0);
+        m_MSTSpin->setSingleStep(0.01);
+        m_MSTSpin->setValue(m_MST);
+        layout->addRow("MST (Migration Start Threshold):", m_MSTSpin);
+
+        m_extraMachineCoefficientSpin = new QDoubleSpinBox(m_configWidget);
+        m_extraMachineCoefficientSpin->setRange(0.0, 10.0);
+        m_extraMachineCoefficientSpin->setSingleStep(0.1);
+        m_extraMachineCoefficientSpin->setValue(m_extraMachineCoefficient);
+        layout->addRow("Extra Machine Coefficient:", m_extraMachineCoefficientSpin);
+
+        m_maxTurnedOnCandidatesSpin = new QSpinBox(m_configWidget);
+        m_maxTurnedOnCandidatesSpin->setRange(0, 100000);
+        m_maxTurnedOnCandidatesSpin->setSpecialValueText("All");
+        m_maxTurnedOnCandidatesSpin->setValue(m_maxTurnedOnCandidates);
+        layout->addRow("Max Turned On Candidates:", m_maxTurnedOnCandidatesSpin);
+
+        m_bundleSizeSpin = new QSpinBox(m_configWidget);
+        m_bundleSizeSpin->setRange(1, 1000);
+        m_bundleSizeSpin->setValue(m_bundleSize);
+        layout->addRow("Bundle Size:", m_bundleSizeSpin);
+
+        m_maxIterationsSpin = new QSpinBox(m_configWidget);
+        m_maxIterationsSpin->setRange(1, 10000);
+        m_maxIterationsSpin->setValue(m_maxIterations);
+        layout->addRow("Max Iterations:", m_maxIterationsSpin);
+
+        m_initialStepSpin = new QDoubleSpinBox(m_configWidget);
+        m_initialStepSpin->setRange(0.01, 2.0);
+        m_initialStepSpin->setSingleStep(0.1);
+        m_initialStepSpin->setValue(m_initialStep);
+        layout->addRow("Initial Step:", m_initialStepSpin);
+
+        m_stallIterationsSpin = new QSpinBox(m_configWidget);
+        m_stallIterationsSpin->setRange(1, 100);
+        m_stallIterationsSpin->setValue(m_stallIterations);
+        layout->addRow("Stall Iterations:", m_stallIterationsSpin);
+
+        m_gapSpin = new QDoubleSpinBox(m_configWidget);
+        m_gapSpin->setDecimals(4);
+        m_gapSpin->setRange(0.0, 1.0);
+        m_gapSpin->setSingleStep(0.001);
+        m_gapSpin->setValue(m_gap);
+        layout->addRow("Gap:", m_gapSpin);
+
+        m_configWidget->setLayout(layout);
+    }
+
+    return m_configWidget;
+}
+
+void LagrangianStrategy::applyConfigFromUI()
+{
+    m_Mu = m_MuSpin->value();
+    m_Tau = m_TauSpin->value();
+    m_Beta = m_BetaSpin->value();
+    m_Gamma = m_GammaSpin->value();
+    m_MST = m_MSTSpin->value();
+    m_extraMachineCoefficient = m_extraMachineCoefficientSpin->value();
+    m_maxTurnedOnCandidates = m_maxTurnedOnCandidatesSpin->value();
+    m_bundleSize = m_bundleSizeSpin->value();
+    m_maxIterations = m_maxIterationsSpin->value();
+    m_initialStep = m_initialStepSpin->value();
+    m_stallIterations = m_stallIterationsSpin->value();
+    m_gap = m_gapSpin->value();
+}
+
+QString LagrangianStrategy::name() const
+{
+    return "Lagrangian Relaxation";
+}
+
+IPlacementStrategy *LagrangianStrategy::clone() const
+{
+    auto *copy = new LagrangianStrategy();
+    copy->m_Mu = m_Mu;
+    copy->m_Tau = m_Tau;
+    copy->m_Beta = m_Beta;
+    copy->m_Gamma = m_Gamma;
+    copy->m_MST = m_MST;
+    copy->m_extraMachineCoefficient = m_extraMachineCoefficient;
+    copy->m_maxTurnedOnCandidates = m_maxTurnedOnCandidates;
+    copy->m_bundleSize = m_bundleSize;
+    copy->m_maxIterations = m_maxIterations;
+    copy->m_initialStep = m_initialStep;
+    copy->m_stallIterations = m_stallIterations;
+    copy->m_gap = m_gap;
+    return copy;
+}
+
+QWidget *LagrangianStrategy::createStatusWidget(QWidget *parent)
+{
+    if (!m_statusWidget)
+    {
+        m_statusWidget = new QWidget(parent);
+        auto layout = new QFormLayout(m_statusWidget);
+
+        auto muLabel = new QLabel(QString::number(m_Mu), m_statusWidget);
+        layout->addRow("Mu (Migration Cost):", muLabel);
+
+        auto tauLabel = new QLabel(QString::number(m_Tau), m_statusWidget);
+        layout->addRow("Tau (Target Utilization after Migration):", tauLabel);
+
+        auto betaLabel = new QLabel(QString::number(m_Beta), m_statusWidget);
+        layout->addRow("Beta (Expected Utilization Scaler for Newcomers):", betaLabel);
+
+        auto gammaLabel = new QLabel(QString::number(m_Gamma), m_statusWidget);
+        layout->addRow("Gamma (Expected Utilization Scaler for Migrations):", gammaLabel);
+
+        auto mstLabel = new QLabel(QString::number(m_MST), m_statusWidget);
+        layout->addRow("MST (Migration Start Threshold):", mstLabel);
+
+        auto bundleSizeLabel = new QLabel(QString::number(m_bundleSize), m_statusWidget);
+        layout->addRow("Bundle Size:", bundleSizeLabel);
+
+        auto maxIterationsLabel = new QLabel(QString::number(m_maxIterations), m_statusWidget);
+        layout->addRow("Max Iterations:", maxIterationsLabel);
+
+        auto gapLabel = new QLabel(QString::number(m_gap), m_statusWidget);
+        layout->addRow("Gap:", gapLabel);
+
+        m_statusWidget->setLayout(layout);
+    }
+
+    return m_statusWidget;
+}
@@ -0,0 +1,391 @@
+#include "strategies/LocalSearchStrategy.h"
+#include "logging/LogManager.h"
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+
+LocalSearchStrategy::LocalSearchStrategy()
+{
+}
+
+LocalSearchStrategy::~LocalSearchStrategy()
+{
+}
+
+Results LocalSearchStrategy::run(const std::vector<VirtualMachine *> &newRequests, const std::vector<VirtualMachine *> &toMigrate, const std::vector<PhysicalMachine> &machines)
+{
+    return runBudgeted(newRequests, toMigrate, machines, PlacementBudget{});
+}
+
+int LocalSearchStrategy::placeNewcomer(const Resources &usage, std::vector<Resources> &load, std::vector<int> &count, std::vector<double> &cost, const PlacementCostModel &model) const
+{
+    int best = -1;
+    double bestDelta = 0;
+    for (size_t i = 0; i < load.size(); ++i)
+    {
+        if (!canHost(load[i] + usage, model.total(i)))
+            continue;
+
+        double delta = model.machineCost(i, load[i] + usage, count[i] + 1) - cost[i];
+        if (best < 0 || delta < bestDelta)
+        {
+            best = i;
+            bestDelta = delta;
+        }
+    }
+
+    if (best >= 0)
+    {
+        load[best] += usage;
+        count[best]++;
+        cost[best] += bestDelta;
+    }
+    return best;
+}
+
+Results LocalSearchStrategy::runBudgeted(const std::vector<VirtualMachine *> &newRequests, const std::vector<VirtualMachine *> &toMigrate, const std::vector<PhysicalMachine> &machines, const PlacementBudget &budget)
+{
+    // The search is anytime, without a caller deadline it stops at its own
+    PlacementBudget limited = budget;
+    if (limited.wallSeconds <= 0)
+        limited.wallSeconds = m_timeLimit;
+    BudgetTracker tracker(limited);
+
+    PlacementCostModel model(machines, m_weights);
+    const size_t n = machines.size();
+
+    std::vector<Resources> load(n);
+    std::vector<int> count(n);
+    std::vector<double> cost(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        load[i] = model.used(i);
+        count[i] = model.vmCount(i);
+        cost[i] = model.machineCost(i, load[i], count[i]);
+    }
+
+    // Decisions refer to the caller's migration candidates, which may be copies of the hosted VMs
+    std::unordered_map<int, VirtualMachine *> candidates;
+    for (auto *vm : toMigrate)
+        candidates[vm->getID()] = vm;
+
+    std::vector<Item> items;
+    for (size_t i = 0; i < n; ++i)
+    {
+        for (auto *vm : machines[i].getVirtualMachines())
+        {
+            // A migrating VM is accounted on both of its PMs until the migration completes
+            if (vm->isMigrating())
+                continue;
+
+            auto candidate = candidates.find(vm->getID());
+            items.push_back({candidate != candidates.end() ? candidate->second : vm, vm->getUsage(), int(i), int(i)});
+        }
+    }
+
+    Results results;
+    results.placementDecision.reserve(newRequests.size());
+
+    std::vector<VirtualMachine *> sortedNew = newRequests;
+    std::sort(sortedNew.begin(), sortedNew.end(), [](VirtualMachine *a, VirtualMachine *b)
+              { return a->getUsage().cpu > b->getUsage().cpu; });
+    std::vector<size_t> newcomerItems;
+    for (auto *vm : sortedNew)
+    {
+        int machine = placeNewcomer(vm->getUsage(), load, count, cost, model);
+        if (machine < 0)
+        {
+            results.placementDecision.push_back({vm, -1});
+            continue;
+        }
+        newcomerItems.push_back(items.size());
+        items.push_back({vm, vm->getUsage(), -1, machine});
+    }
+
+    // Migration cost of moving an item from one PM to another, relative to its origin
+    auto migrationDelta = [this](const Item &item, int from, int to)
+    {
+        if (item.origin < 0)
+            return 0.0;
+        return (to != item.origin ? m_weights.migration : 0.0) - (from != item.origin ? m_weights.migration : 0.0);
+    };
+
+    double current = 0;
+    for (double machineCost : cost)
+        current += machineCost;
+    double best = current;
+    m_lastInitialCost = current;
+
+    // Accepted moves since the best placement was last recorded, replayed onto it at the next improvement
+    std::vector<int> bestMachine(items.size());
+    for (size_t k = 0; k < items.size(); ++k)
+        bestMachine[k] = items[k].machine;
+    std::vector<std::pair<size_t, int>> journal;
+
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::uniform_int_distribution<size_t> pickItem(0, items.empty() ? 0 : items.size() - 1);
+    std::uniform_int_distribution<size_t> pickMachine(0, n == 0 ? 0 : n - 1);
+
+    double temperature = m_initialTemperature;
+    size_t iteration = 0, accepted = 0;
+    bool stopped = false;
+    for (; iteration < m_maxIterations && items.size() > 1 && n > 1; ++iteration)
+    {
+        if (iteration % 256 == 0 && tracker.exhausted(iteration))
+        {
+            stopped = true;
+            break;
+        }
+        temperature *= m_cooling;
+
+        size_t a = pickItem(m_rng);
+        const int p = items[a].machine;
+
+        size_t b = 0;
+        int q = -1;
+        bool swap = unit(m_rng) < m_swapProbability;
+        if (swap)
+        {
+            b = pickItem(m_rng);
+            q = items[b].machine;
+        }
+        else
+        {
+            // Mostly towards PMs that already host a VM, now and then towards any PM
+            q = unit(m_rng) < 0.9 ? items[pickItem(m_rng)].machine : int(pickMachine(m_rng));
+        }
+        if (q == p)
+            continue;
+
+        Resources loadP, loadQ;
+        int countP = count[p], countQ = count[q];
+        double delta = migrationDelta(items[a], p, q);
+        if (swap)
+        {
+            loadP = load[p] - items[a].usage + items[b].usage;
+            loadQ = load[q] - items[b].usage + items[a].usage;
+            if (!canHost(loadP, model.total(p)) || !canHost(loadQ, model.total(q)))
+                continue;
+            delta += migrationDelta(items[b], q, p);
+        }
+        else
+        {
+            loadP = load[p] - items[a].usage;
+            loadQ = load[q] + items[a].usage;
+            if (!canHost(loadQ, model.total(q)))
+                continue;
+            countP--;
+            countQ++;
+        }
+
+        double costP = model.machineCost(p, loadP, countP);
+        double costQ = model.machineCost(q, loadQ, countQ);
+        delta += costP - cost[p] + costQ - cost[q];
+
+        if (delta >= 0 && (temperature <= 0 || unit(m_rng) >= std::exp(-delta / temperature)))
+            continue;
+
+        load[p] = loadP;
+        load[q] = loadQ;
+        count[p] = countP;
+        count[q] = countQ;
+        cost[p] = costP;
+        cost[q] = costQ;
+        items[a].machine = q;
+        journal.push_back({a, q});
+        if (swap)
+        {
+            items[b].machine = p;
+            journal.push_back({b, p});
+        }
+        current += delta;
+        accepted++;
+
+        if (current < best - 1e-9)
+        {
+            best = current;
+            for (auto &[item, machine] : journal)
+                bestMachine[item] = machine;
+            journal.clear();
+        }
+    }
+
+    for (size_t k : newcomerItems)
+        results.placementDecision.push_back({items[k].vm, model.id(bestMachine[k])});
+
+    for (size_t k = 0; k < items.size(); ++k)
+    {
+        if (items[k].origin >= 0 && bestMachine[k] != items[k].origin)
+            results.migrationDecision.push_back({items[k].vm, model.id(bestMachine[k])});
+    }
+
+    m_lastCost = best;
+    m_lastIterations = iteration;
+    m_lastAccepted = accepted;
+    m_lastMigrations = results.migrationDecision.size();
+
+    results.quality.objective = best;
+    results.quality.iterations = iteration;
+    results.quality.complete = !stopped;
+    results.quality.seconds = tracker.elapsed();
+    LogManager::instance().log(LogCategory::DEBUG, "LocalSearchStrategy: Cost " + std::to_string(m_lastInitialCost) + " -> " + std::to_string(best) + " with " + std::to_string(m_lastMigrations) + " migrations after " + std::to_string(iteration) + " iterations (" + std::to_string(accepted) + " accepted) in " + std::to_string(results.quality.seconds) + " s");
+
+    return results;
+}
+
+double LocalSearchStrategy::getMigrationThreshold()
+{
+    return m_MST;
+}
+
+size_t LocalSearchStrategy::getBundleSize()
+{
+    return m_bundleSize;
+}
+
+QWidget *LocalSearchStrategy::createConfigWidget(QWidget *parent)
+{
+    if (!m_configWidget)
+    {
+        m_configWidget = new QWidget(parent);
+        auto layout = new QFormLayout(m_configWidget);
+
+        m_MuSpin = new QDoubleSpinBox(m_configWidget);
+        m_MuSpin->setRange(0.0, 1000.0);
+        m_MuSpin->setSingleStep(1.0);
+        m_MuSpin->setValue(m_weights.migration);
+        layout->addRow("Mu (Migration Cost):", m_MuSpin);
+
+        m_overloadWeightSpin = new QDoubleSpinBox(m_configWidget);
+        m_overloadWeightSpin->setRange(0.0, 100000.0);
+        m_overloadWeightSpin->setSingleStep(10.0);
+        m_overloadWeightSpin->setValue(m_weights.overload);
+        layout->addRow("Overload Weight:", m_overloadWeightSpin);
+
+        m_overloadThresholdSpin = new QDoubleSpinBox(m_configWidget);
+        m_overloadThresholdSpin->setRange(0.0, 1.0);
+        m_overloadThresholdSpin->setSingleStep(0.01);
+        m_overloadThresholdSpin->setValue(m_weights.overloadThreshold);
+        layout->addRow("Overload Threshold:", m_overloadThresholdSpin);
+
+        m_fragmentationWeightSpin = new QDoubleSpinBox(m_configWidget);
+        m_fragmentationWeightSpin->setRange(0.0, 10000.0);
+        m_fragmentationWeightSpin->setSingleStep(1.0);
+        m_fragmentationWeightSpin->setValue(m_weights.fragmentation);
+        layout->addRow("Fragmentation Weight:", m_fragmentationWeightSpin);
+
+        m_timeLimitSpin = new QDoubleSpinBox(m_configWidget);
+        m_timeLimitSpin->setRange(0.01, 3600.0);
+        m_timeLimitSpin->setSingleStep(0.1);
+        m_timeLimitSpin->setSuffix(" s");
+        m_timeLimitSpin->setValue(m_timeLimit);
+        layout->addRow("Time Limit:", m_timeLimitSpin);
+
+        m_maxIterationsSpin = new QSpinBox(m_configWidget);
+        m_maxIterationsSpin->setRange(1, 100000000);
+        m_maxIterationsSpin->setValue(m_maxIterations);
+        layout->addRow("Max Iterations:", m_maxIterationsSpin);
+
+        m_initialTemperatureSpin = new QDoubleSpinBox(m_configWidget);
+        m_initialTemperatureSpin->setRange(0.0, 100000.0);
+        m_initialTemperatureSpin->setSingleStep(1.0);
+        m_initialTemperatureSpin->setValue(m_initialTemperature);
+        layout->addRow("Initial Temperature:", m_initialTemperatureSpin);
+
+        m_coolingSpin = new QDoubleSpinBox(m_configWidget);
+        m_coolingSpin->setDecimals(6);
+        m_coolingSpin->setRange(0.0, 1.0);
+        m_coolingSpin->setSingleStep(0.0001);
+        m_coolingSpin->setValue(m_cooling);
+        layout->addRow("Cooling Factor:", m_coolingSpin);
+
+        m_swapProbabilitySpin = new QDoubleSpinBox(m_configWidget);
+        m_swapProbabilitySpin->setRange(0.0, 1.0);
+        m_swapProbabilitySpin->setSingleStep(0.05);
+        m_swapProbabilitySpin->setValue(m_swapProbability);
+        layout->addRow("Swap Probability:", m_swapProbabilitySpin);
+
+        m_MSTSpin = new QDoubleSpinBox(m_configWidget);
+        m_MSTSpin->setRange(0.0, 1.0);
+        m_MSTSpin->setSingleStep(0.01);
+        m_MSTSpin->setValue(m_MST);
+        layout->addRow("MST (Migration Start Threshold):", m_MSTSpin);
+
+        m_bundleSizeSpin = new QSpinBox(m_configWidget);
+        m_bundleSizeSpin->setRange(1, 1000);
+        m_bundleSizeSpin->setValue(m_bundleSize);
+        layout->addRow("Bundle Size:", m_bundleSizeSpin);
+
+        m_configWidget->setLayout(layout);
+    }
+
+    return m_configWidget;
+}
+
+void LocalSearchStrategy::applyConfigFromUI()
+{
+    m_weights.migration = m_MuSpin->value();
+    m_weights.overload = m_overloadWeightSpin->value();
+    m_weights.overloadThreshold = m_overloadThresholdSpin->value();
+    m_weights.fragmentation = m_fragmentationWeightSpin->value();
+    m_timeLimit = m_timeLimitSpin->value();
+    m_maxIterations = m_maxIterationsSpin->value();
+    m_initialTemperature = m_initialTemperatureSpin->value();
+    m_cooling = m_coolingSpin->value();
+    m_swapProbability = m_swapProbabilitySpin->value();
+    m_MST = m_MSTSpin->value();
+    m_bundleSize = m_bundleSizeSpin->value();
+}
+
+QString LocalSearchStrategy::name() const
+{
+    return "Local Search";
+}
+
+IPlacementStrategy *LocalSearchStrategy::clone() const
+{
+    auto *copy = new LocalSearchStrategy();
+    copy->m_weights = m_weights;
+    copy->m_timeLimit = m_timeLimit;
+    copy->m_maxIterations = m_maxIterations;
+    copy->m_initialTemperature = m_initialTemperature;
+    copy->m_cooling = m_cooling;
+    copy->m_swapProbability = m_swapProbability;
+    copy->m_MST = m_MST;
+    copy->m_bundleSize = m_bundleSize;
+    return copy;
+}
+
+QWidget *LocalSearchStrategy::createStatusWidget(QWidget *parent)
+{
+    if (!m_statusWidget)
+    {
+        m_statusWidget = new QWidget(parent);
+        auto layout = new QFormLayout(m_statusWidget);
+
+        auto muLabel = new QLabel(QString::number(m_weights.migration), m_statusWidget);
+        layout->addRow("Mu (Migration Cost):", muLabel);
+
+        auto timeLimitLabel = new QLabel(QString::number(m_timeLimit) + " s", m_statusWidget);
+        layout->addRow("Time Limit:", timeLimitLabel);
+
+        auto costLabel = new QLabel(QString::number(m_lastInitialCost) + " -> " + QString::number(m_lastCost), m_statusWidget);
+        layout->addRow("Last Cost:", costLabel);
+
+        auto iterationsLabel = new QLabel(QString::number(m_lastAccepted) + " / " + QString::number(m_lastIterations), m_statusWidget);
+        layout->addRow("Accepted / Iterations:", iterationsLabel);
+
+        auto migrationsLabel = new QLabel(QString::number(m_lastMigrations), m_statusWidget);
+        layout->addRow("Last Migrations:", migrationsLabel);
+
+        auto mstLabel = new QLabel(QString::number(m_MST), m_statusWidget);
+        layout->addRow("MST (Migration Start Threshold):", mstLabel);
+
+        auto bundleSizeLabel = new QLabel(QString::number(m_bundleSize), m_statusWidget);
+        layout->addRow("Bundle Size:", bundleSizeLabel);
+
+        m_statusWidget->setLayout(layout);
+    }
+
+    return m_statusWidget;
+}
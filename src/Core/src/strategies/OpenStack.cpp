@@ -185,6 +185,13 @@ QString OpenStack::name() const
     return "OpenStack";
 }
 
+IPlacementStrategy *OpenStack::clone() const
+{
+    auto *copy = new OpenStack();
+    copy->m_ial = m_ial;
+    return copy;
+}
+
 QWidget *OpenStack::createStatusWidget(QWidget *parent)
 {
     if (!m_statusWidget)
@@ -0,0 +1,246 @@
+#include "strategies/PlacementCostModel.h"
+#include <algorithm>
+#include <limits>
+#include <thread>
+#include <unordered_map>
+
+PlacementCostModel::PlacementCostModel(const std::vector<PhysicalMachine> &machines, const Weights &weights)
+    : m_weights(weights)
+{
+    const size_t n = machines.size();
+    for (auto *field : {&m_usedCPU, &m_usedRAM, &m_usedDisk, &m_usedBandwidth, &m_usedFPGA, &m_totalCPU, &m_totalRAM, &m_totalDisk, &m_totalBandwidth, &m_totalFPGA, &m_powerOnCost, &m_powerCPU, &m_powerFPGA})
+        field->reserve(n);
+    m_ids.reserve(n);
+    m_vmCount.reserve(n);
+    m_turnedOn.reserve(n);
+
+    int maxID = -1;
+    for (auto &machine : machines)
+    {
+        Resources used = machine.getUsed();
+        Resources total = machine.getTotal();
+
+        m_ids.push_back(machine.getID());
+        m_usedCPU.push_back(used.cpu);
+        m_usedRAM.push_back(used.ram);
+        m_usedDisk.push_back(used.disk);
+        m_usedBandwidth.push_back(used.bandwidth);
+        m_usedFPGA.push_back(used.fpga);
+        m_totalCPU.push_back(total.cpu);
+        m_totalRAM.push_back(total.ram);
+        m_totalDisk.push_back(total.disk);
+        m_totalBandwidth.push_back(total.bandwidth);
+        m_totalFPGA.push_back(total.fpga);
+        m_vmCount.push_back(machine.getVirtualMachines().size());
+        m_turnedOn.push_back(machine.isTurnedOn());
+        m_powerOnCost.push_back(machine.getPowerOnCost());
+        m_powerCPU.push_back(machine.getPowerConsumptionCPU());
+        m_powerFPGA.push_back(machine.getPowerConsumptionFPGA());
+
+        maxID = std::max(maxID, machine.getID());
+    }
+
+    m_index.assign(maxID + 1, -1);
+    for (size_t i = 0; i < n; ++i)
+        m_index[m_ids[i]] = i;
+
+    m_base.reserve(n);
+    for (size_t i = 0; i < n; ++i)
+        m_base.push_back(terms(i, used(i), m_vmCount[i]));
+}
+
+int PlacementCostModel::indexOf(int pmId) const
+{
+    return pmId >= 0 && pmId < int(m_index.size()) ? m_index[pmId] : -1;
+}
+
+Resources PlacementCostModel::used(size_t i) const
+{
+    return Resources(m_usedCPU[i], m_usedRAM[i], m_usedDisk[i], m_usedBandwidth[i], m_usedFPGA[i]);
+}
+
+Resources PlacementCostModel::total(size_t i) const
+{
+    return Resources(m_totalCPU[i], m_totalRAM[i], m_totalDisk[i], m_totalBandwidth[i], m_totalFPGA[i]);
+}
+
+PlacementCostModel::Terms PlacementCostModel::terms(size_t i, const Resources &used, int vmCount) const
+{
+    Terms terms;
+
+    // An empty PM is turned off, unless it was already on and empty in the snapshot
+    bool on = vmCount > 0 || (m_vmCount[i] == 0 && m_turnedOn[i]);
+    if (on)
+        terms.power = m_weights.power * (m_powerOnCost[i] + m_powerCPU[i] * used.cpu + m_powerFPGA[i] * used.fpga);
+
+    const double loads[] = {used.cpu, used.ram, used.disk, used.bandwidth, used.fpga};
+    const double totals[] = {m_totalCPU[i], m_totalRAM[i], m_totalDisk[i], m_totalBandwidth[i], m_totalFPGA[i]};
+
+    double minFree = 1.0, maxFree = 0.0;
+    for (int d = 0; d < 5; ++d)
+    {
+        if (loads[d] > totals[d] + 1e-9)
+            terms.violated = true;
+        if (totals[d] <= 0)
+            continue;
+
+        double utilization = loads[d] / totals[d];
+        terms.overload += std::max(0.0, utilization - m_weights.overloadThreshold);
+        minFree = std::min(minFree, 1.0 - utilization);
+        maxFree = std::max(maxFree, 1.0 - utilization);
+    }
+    terms.overload *= m_weights.overload;
+
+    // Free capacity is only usable up to the most exhausted dimension, the spread is stranded
+    if (on && maxFree > minFree)
+        terms.fragmentation = m_weights.fragmentation * (maxFree - std::max(0.0, minFree));
+
+    return terms;
+}
+
+double PlacementCostModel::machineCost(size_t i, const Resources &used, int vmCount) const
+{
+    Terms machine = terms(i, used, vmCount);
+    return machine.power + machine.overload + machine.fragmentation;
+}
+
+void PlacementCostModel::accumulate(PlacementCost &cost, size_t i, const Touched &touched) const
+{
+    Terms after = terms(i, used(i) + touched.delta, m_vmCount[i] + touched.vmDelta);
+    const Terms &before = m_base[i];
+
+    cost.power += after.power - before.power;
+    cost.overload += after.overload - before.overload;
+    cost.fragmentation += after.fragmentation - before.fragmentation;
+
+    // A PM already past its capacity still counts when the decision adds to it
+    const Resources &d = touched.delta;
+    bool gained = touched.vmDelta > 0 || d.cpu > 0 || d.ram > 0 || d.disk > 0 || d.bandwidth > 0 || d.fpga > 0;
+    if (after.violated && gained)
+        cost.violations++;
+}
+
+PlacementCost PlacementCostModel::evaluate(const Results &results) const
+{
+    PlacementCost cost;
+    std::unordered_map<int, Touched> touched;
+    touched.reserve(2 * (results.placementDecision.size() + results.migrationDecision.size()));
+
+    for (auto &decision : results.placementDecision)
+    {
+        if (decision.pmId < 0)
+        {
+            cost.unplaced++;
+            continue;
+        }
+
+        int to = indexOf(decision.pmId);
+        if (to < 0)
+        {
+            cost.violations++;
+            continue;
+        }
+        touched[to].delta += decision.vm->getUsage();
+        touched[to].vmDelta++;
+    }
+
+    for (auto &decision : results.migrationDecision)
+    {
+        if (decision.pmId < 0 || decision.pmId == decision.vm->getPMID())
+            continue;
+
+        int to = indexOf(decision.pmId);
+        if (to < 0)
+        {
+            cost.violations++;
+            continue;
+        }
+
+        Resources usage = decision.vm->getUsage();
+        touched[to].delta += usage;
+        touched[to].vmDelta++;
+
+        int from = indexOf(decision.vm->getPMID());
+        if (from >= 0)
+        {
+            touched[from].delta -= usage;
+            touched[from].vmDelta--;
+        }
+        cost.migration += m_weights.migration;
+    }
+
+    for (auto &[i, change] : touched)
+        accumulate(cost, i, change);
+
+    return cost;
+}
+
+std::vector<PlacementCost> PlacementCostModel::evaluateBatch(const std::vector<Results> &candidates, unsigned threads) const
+{
+    std::vector<PlacementCost> costs(candidates.size());
+
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = std::min<unsigned>(threads, candidates.size());
+
+    if (threads <= 1)
+    {
+        for (size_t k = 0; k < candidates.size(); ++k)
+            costs[k] = evaluate(candidates[k]);
+        return costs;
+    }
+
+    // The model is read-only, every thread takes every threads-th candidate
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([this, &candidates, &costs, t, threads]()
+                             {
+            for (size_t k = t; k < candidates.size(); k += threads)
+                costs[k] = evaluate(candidates[k]); });
+    }
+    for (auto &worker : workers)
+    {
+        worker.join();
+    }
+
+    return costs;
+}
+
+double PlacementCostModel::moveCost(const Resources &load, int fromPmId, int toPmId) const
+{
+    int from = indexOf(fromPmId);
+    int to = indexOf(toPmId);
+    if (from == to)
+        return 0.0;
+
+    PlacementCost cost;
+    if (to >= 0)
+        accumulate(cost, to, Touched{load, 1});
+    if (from >= 0)
+    {
+        accumulate(cost, from, Touched{Resources() - load, -1});
+        cost.migration += m_weights.migration;
+    }
+
+    return cost.violations > 0 ? std::numeric_limits<double>::infinity() : cost.total();
+}
+
+void PlacementCostModel::placementCosts(const Resources &load, std::vector<double> &costs) const
+{
+    const size_t n = m_ids.size();
+    costs.resize(n);
+
+    // One pass over the arrays, the fit test reads the fields directly and only fitting PMs are costed
+    for (size_t i = 0; i < n; ++i)
+    {
+        bool fits = m_usedCPU[i] + load.cpu <= m_totalCPU[i] && m_usedRAM[i] + load.ram <= m_totalRAM[i] && m_usedDisk[i] + load.disk <= m_totalDisk[i] &&
+                    m_usedBandwidth[i] + load.bandwidth <= m_totalBandwidth[i] && m_usedFPGA[i] + load.fpga <= m_totalFPGA[i];
+        costs[i] = std::numeric_limits<double>::infinity();
+        if (!fits)
+            continue;
+
+        Terms after = terms(i, used(i) + load, m_vmCount[i] + 1);
+        costs[i] = (after.power - m_base[i].power) + (after.overload - m_base[i].overload) + (after.fragmentation - m_base[i].fragmentation);
+    }
+}
@@ -0,0 +1,353 @@
+#include "strategies/PortfolioStrategy.h"
+#include "strategies/StrategyFactory.h"
+#include "logging/LogManager.h"
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <future>
+#include <limits>
+#include <QFormLayout>
+#include <QLabel>
+
+PortfolioStrategy::PortfolioStrategy()
+{
+#ifdef CDC_WITH_CPLEX
+    setMembers({"BestFitDecreasing", "PAPSO", "ILPStrategy"});
+#else
+    setMembers({"BestFitDecreasing", "PAPSO", "LagrangianRelaxation"});
+#endif
+    applyPendingMembers();
+}
+
+PortfolioStrategy::~PortfolioStrategy()
+{
+    for (auto &member : m_members)
+    {
+        delete member.strategy;
+    }
+}
+
+void PortfolioStrategy::setMembers(const std::vector<QString> &names)
+{
+    // An async placement may be racing the current members, they are replaced when the next run starts
+    std::lock_guard<std::mutex> lock(m_statisticsMutex);
+    m_pendingMembers = names;
+    m_membersPending = true;
+}
+
+void PortfolioStrategy::applyPendingMembers()
+{
+    std::vector<QString> names;
+    {
+        std::lock_guard<std::mutex> lock(m_statisticsMutex);
+        if (!m_membersPending)
+            return;
+        names.swap(m_pendingMembers);
+        m_membersPending = false;
+    }
+
+    // Members that stay keep their instance, their warm starts and their statistics
+    std::vector<Member> members;
+    for (const auto &name : names)
+    {
+        auto existing = std::find_if(m_members.begin(), m_members.end(), [&name](const Member &member)
+                                     { return member.statistics.name == name; });
+        if (existing != m_members.end())
+        {
+            members.push_back(*existing);
+            existing->strategy = nullptr;
+            continue;
+        }
+
+        Member member;
+        member.strategy = StrategyFactory::create(name);
+        member.statistics.name = name;
+        members.push_back(member);
+    }
+
+    for (auto &member : m_members)
+    {
+        delete member.strategy;
+    }
+
+    std::lock_guard<std::mutex> lock(m_statisticsMutex);
+    m_members = std::move(members);
+}
+
+Results PortfolioStrategy::run(const std::vector<VirtualMachine *> &newRequests, const std::vector<VirtualMachine *> &toMigrate, const std::vector<PhysicalMachine> &machines)
+{
+    return runBudgeted(newRequests, toMigrate, machines, PlacementBudget{});
+}
+
+Results PortfolioStrategy::runBudgeted(const std::vector<VirtualMachine *> &newRequests, const std::vector<VirtualMachine *> &toMigrate, const std::vector<PhysicalMachine> &machines, const PlacementBudget &budget)
+{
+    BudgetTracker tracker(budget);
+    applyPendingMembers();
+
+    if (m_members.empty())
+    {
+        Results results;
+        for (auto *vm : newRequests)
+            results.placementDecision.push_back({vm, -1});
+        return results;
+    }
+
+    // Every member gets the caller's limits, cancellation goes through the portfolio token
+    m_cancel = false;
+    PlacementBudget memberBudget = budget;
+    memberBudget.cancel = &m_cancel;
+
+    struct Entry
+    {
+        std::future<Results> results;
+        double seconds{0.0};
+    };
+    std::vector<Entry> entries(m_members.size());
+    for (size_t k = 0; k < m_members.size(); ++k)
+    {
+        IPlacementStrategy *strategy = m_members[k].strategy;
+        double *seconds = &entries[k].seconds;
+        entries[k].results = std::async(std::launch::async, [&, strategy, seconds]()
+                                        {
+            auto start = std::chrono::steady_clock::now();
+            Results results = strategy->runBudgeted(newRequests, toMigrate, machines, memberBudget);
+            *seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            return results; });
+    }
+
+    // Cancel the stragglers once the deadline passes or the caller gives up
+    for (auto &entry : entries)
+    {
+        while (entry.results.wait_for(std::chrono::milliseconds(5)) != std::future_status::ready)
+        {
+            if (tracker.cancelled() || tracker.remaining() <= 0)
+                m_cancel = true;
+        }
+    }
+
+    PlacementCostModel::Weights weights;
+    weights.migration = m_Mu;
+    PlacementCostModel model(machines, weights);
+
+    int winner = -1;
+    bool winnerOnTime = false;
+    Score winnerScore;
+    Results best;
+    std::vector<char> ran(m_members.size(), 0);
+    for (size_t k = 0; k < entries.size(); ++k)
+    {
+        Results results;
+        try
+        {
+            results = entries[k].results.get();
+        }
+        catch (const std::exception &e)
+        {
+            LogManager::instance().log(LogCategory::WARNING, "Portfolio: " + m_members[k].statistics.name.toStdString() + " failed: " + e.what());
+            continue;
+        }
+        ran[k] = 1;
+
+        bool onTime = budget.wallSeconds <= 0 || entries[k].seconds <= budget.wallSeconds;
+        Score candidate = score(results, newRequests, model);
+        if (winner < 0 || (onTime && !winnerOnTime) || (onTime == winnerOnTime && candidate < winnerScore))
+        {
+            winner = k;
+            winnerOnTime = onTime;
+            winnerScore = candidate;
+            best = std::move(results);
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_statisticsMutex);
+        for (size_t k = 0; k < m_members.size(); ++k)
+        {
+            if (!ran[k])
+                continue;
+
+            auto &statistics = m_members[k].statistics;
+            statistics.runs++;
+            statistics.totalSeconds += entries[k].seconds;
+            statistics.maxSeconds = std::max(statistics.maxSeconds, entries[k].seconds);
+        }
+        if (winner >= 0)
+            m_members[winner].statistics.wins++;
+    }
+
+    if (winner < 0)
+        throw std::runtime_error("Portfolio: every member strategy failed");
+
+    LogManager::instance().log(LogCategory::STRATEGY, "Portfolio: " + m_members[winner].statistics.name.toStdString() + " won with cost " + std::to_string(winnerScore.cost) + ", " + std::to_string(winnerScore.unplaced) + " unplaced, in " + std::to_string(entries[winner].seconds) + " s");
+
+    best.quality.objective = winnerScore.cost;
+    best.quality.seconds = tracker.elapsed();
+    return best;
+}
+
+bool PortfolioStrategy::Score::operator<(const Score &rhs) const
+{
+    if (feasible != rhs.feasible)
+        return feasible;
+    if (unplaced != rhs.unplaced)
+        return unplaced < rhs.unplaced;
+    return cost < rhs.cost;
+}
+
+PortfolioStrategy::Score PortfolioStrategy::score(const Results &results, const std::vector<VirtualMachine *> &newRequests, const PlacementCostModel &model) const
+{
+    PlacementCost cost = model.evaluate(results);
+
+    Score total;
+    total.feasible = cost.violations == 0;
+    size_t placed = results.placementDecision.size() - cost.unplaced;
+    total.unplaced = newRequests.size() - std::min(placed, newRequests.size());
+    total.cost = cost.total();
+    return total;
+}
+
+std::vector<PortfolioStrategy::MemberStatistics> PortfolioStrategy::getMemberStatistics() const
+{
+    std::lock_guard<std::mutex> lock(m_statisticsMutex);
+    std::vector<MemberStatistics> statistics;
+    for (auto &member : m_members)
+        statistics.push_back(member.statistics);
+    return statistics;
+}
+
+double PortfolioStrategy::getMigrationThreshold()
+{
+    return m_MST;
+}
+
+size_t PortfolioStrategy::getBundleSize()
+{
+    return m_bundleSize;
+}
+
+QWidget *PortfolioStrategy::createConfigWidget(QWidget *parent)
+{
+    if (!m_configWidget)
+    {
+        m_configWidget = new QWidget(parent);
+        auto layout = new QFormLayout(m_configWidget);
+
+        // The member set the next run races, pending changes included
+        std::vector<QString> names;
+        {
+            std::lock_guard<std::mutex> lock(m_statisticsMutex);
+            if (m_membersPending)
+                names = m_pendingMembers;
+            else
+            {
+                for (auto &member : m_members)
+                    names.push_back(member.statistics.name);
+            }
+        }
+
+        // Any strategy the factory knows can race, except this one and the DQN agent that needs the live data center
+        for (auto &info : StrategyFactory::availableStrategies())
+        {
+            if (info.name == "Portfolio" || info.name == "ILP + DQN Strategy")
+                continue;
+
+            auto check = new QCheckBox(m_configWidget);
+            check->setChecked(std::find(names.begin(), names.end(), info.name) != names.end());
+            layout->addRow(info.name + ":", check);
+            m_memberChecks.push_back({info.name, check});
+        }
+
+        m_MuSpin = new QDoubleSpinBox(m_configWidget);
+        m_MuSpin->setRange(0.0, 1000.0);
+        m_MuSpin->setSingleStep(1.0);
+        m_MuSpin->setValue(m_Mu);
+        layout->addRow("Mu (Migration Cost):", m_MuSpin);
+
+        m_MSTSpin = new QDoubleSpinBox(m_configWidget);
+        m_MSTSpin->setRange(0.0, 1.0);
+        m_MSTSpin->setSingleStep(0.01);
+        m_MSTSpin->setValue(m_MST);
+        layout->addRow("MST (Migration Start Threshold):", m_MSTSpin);
+
+        m_bundleSizeSpin = new QSpinBox(m_configWidget);
+        m_bundleSizeSpin->setRange(1, 1000);
+        m_bundleSizeSpin->setValue(m_bundleSize);
+        layout->addRow("Bundle Size:", m_bundleSizeSpin);
+
+        m_configWidget->setLayout(layout);
+    }
+
+    return m_configWidget;
+}
+
+void PortfolioStrategy::applyConfigFromUI()
+{
+    std::vector<QString> names;
+    for (auto &[name, check] : m_memberChecks)
+    {
+        if (check->isChecked())
+            names.push_back(name);
+    }
+    setMembers(names);
+
+    m_Mu = m_MuSpin->value();
+    m_MST = m_MSTSpin->value();
+    m_bundleSize = m_bundleSizeSpin->value();
+}
+
+QString PortfolioStrategy::name() const
+{
+    return "Portfolio";
+}
+
+IPlacementStrategy *PortfolioStrategy::clone() const
+{
+    std::vector<QString> names;
+    {
+        std::lock_guard<std::mutex> lock(m_statisticsMutex);
+        if (m_membersPending)
+            names = m_pendingMembers;
+        else
+        {
+            for (auto &member : m_members)
+                names.push_back(member.statistics.name);
+        }
+    }
+
+    auto *copy = new PortfolioStrategy();
+    copy->setMembers(names);
+    copy->m_Mu = m_Mu;
+    copy->m_MST = m_MST;
+    copy->m_bundleSize = m_bundleSize;
+    return copy;
+}
+
+QWidget *PortfolioStrategy::createStatusWidget(QWidget *parent)
+{
+    if (!m_statusWidget)
+    {
+        m_statusWidget = new QWidget(parent);
+        auto layout = new QFormLayout(m_statusWidget);
+
+        for (auto &statistics : getMemberStatistics())
+        {
+            double winRate = statistics.runs > 0 ? 100.0 * statistics.wins / statistics.runs : 0.0;
+            double averageMs = statistics.runs > 0 ? 1000.0 * statistics.totalSeconds / statistics.runs : 0.0;
+            auto label = new QLabel(QString("%1 / %2 wins (%3%), %4 ms average").arg(statistics.wins).arg(statistics.runs).arg(winRate, 0, 'f', 1).arg(averageMs, 0, 'f', 1), m_statusWidget);
+            layout->addRow(statistics.name + ":", label);
+        }
+
+        auto muLabel = new QLabel(QString::number(m_Mu), m_statusWidget);
+        layout->addRow("Mu (Migration Cost):", muLabel);
+
+        auto mstLabel = new QLabel(QString::number(m_MST), m_statusWidget);
+        layout->addRow("MST (Migration Start Threshold):", mstLabel);
+
+        auto bundleSizeLabel = new QLabel(QString::number(m_bundleSize), m_statusWidget);
+        layout->addRow("Bundle Size:", bundleSizeLabel);
+
+        m_statusWidget->setLayout(layout);
+    }
+
+    return m_statusWidget;
+}
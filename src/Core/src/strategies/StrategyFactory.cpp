@@ -2,9 +2,18 @@
 #include "strategies/FirstFitDecreasing.h"
 #include "strategies/BestFitDecreasing.h"
 #include "strategies/AlphaBetaStrategy.h"
+#include "strategies/LagrangianStrategy.h"
+#include "strategies/LocalSearchStrategy.h"
+#include "strategies/HarmonicStrategy.h"
+#include "strategies/PortfolioStrategy.h"
+#ifdef CDC_WITH_CPLEX
 #include "strategies/ILPStrategy.h"
+#endif
+#if defined(CDC_WITH_CPLEX) && defined(CDC_WITH_TORCH)
 #include "strategies/drl/ILPDQNStrategy.h"
+#endif
 #include "strategies/pso/PAPSOStrategy.h"
+#include "strategies/pso/DiscretePSOStrategy.h"
 #include "strategies/OpenStack.h"
 
 std::vector<StrategyInfo> StrategyFactory::availableStrategies()
@@ -13,9 +22,18 @@ std::vector<StrategyInfo> StrategyFactory::availableStrategies()
     list.push_back({"FirstFitDecreasing"});
     list.push_back({"BestFitDecreasing"});
     list.push_back({"AlphaBetaStrategy"});
+#ifdef CDC_WITH_CPLEX
     list.push_back({"ILPStrategy"});
+#endif
+#if defined(CDC_WITH_CPLEX) && defined(CDC_WITH_TORCH)
     list.push_back({"ILP + DQN Strategy"});
+#endif
+    list.push_back({"LagrangianRelaxation"});
+    list.push_back({"LocalSearch"});
+    list.push_back({"Harmonic"});
+    list.push_back({"Portfolio"});
     list.push_back({"PAPSO"});
+    list.push_back({"Discrete Island PSO"});
     list.push_back({"OpenStack"});
     return list;
 }
@@ -34,18 +52,42 @@ IPlacementStrategy *StrategyFactory::create(const QString &name)
     {
         return new AlphaBetaStrategy();
     }
+#ifdef CDC_WITH_CPLEX
     else if (name == "ILPStrategy")
     {
         return new ILPStrategy();
     }
+#endif
+#if defined(CDC_WITH_CPLEX) && defined(CDC_WITH_TORCH)
     else if (name == "ILP + DQN Strategy")
     {
         return new ILPDQNStrategy();
     }
+#endif
+    else if (name == "LagrangianRelaxation")
+    {
+        return new LagrangianStrategy();
+    }
+    else if (name == "LocalSearch")
+    {
+        return new LocalSearchStrategy();
+    }
+    else if (name == "Harmonic")
+    {
+        return new HarmonicStrategy();
+    }
+    else if (name == "Portfolio")
+    {
+        return new PortfolioStrategy();
+    }
     else if (name == "PAPSO")
     {
         return new PAPSOStrategy();
     }
+    else if (name == "Discrete Island PSO")
+    {
+        return new DiscretePSOStrategy();
+    }
     else if (name == "OpenStack")
     {
         return new OpenStack();
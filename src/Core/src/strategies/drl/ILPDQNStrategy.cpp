@@ -38,7 +38,7 @@ ILPDQNStrategy::~ILPDQNStrategy()
     delete m_agent;
 }
 
-Results ILPDQNStrategy::run(const std::vector<VirtualMachine *> &newRequests, const std::vector<VirtualMachine *> &toMigrate, const std::vector<PhysicalMachine> &machines)
+Results ILPDQNStrategy::runBudgeted(const std::vector<VirtualMachine *> &newRequests, const std::vector<VirtualMachine *> &toMigrate, const std::vector<PhysicalMachine> &machines, const PlacementBudget &budget)
 {
     // Build a state vector
     auto state = ComputeState();
@@ -55,7 +55,7 @@ Results ILPDQNStrategy::run(const std::vector<VirtualMachine *> &newRequests, co
 
     LogManager::instance().log(LogCategory::DEBUG, "ILPDQNStrategy: Selected action: BundleSize = " + std::to_string(m_bundleSize) + " Mu = " + std::to_string(m_Mu) + ", Tau = " + std::to_string(m_Tau) + ", Beta = " + std::to_string(m_Beta) + ", Gamma = " + std::to_string(m_Gamma) + ", MST = " + std::to_string(m_MST));
 
-    Results res = ILPStrategy::run(newRequests, toMigrate, machines);
+    Results res = ILPStrategy::runBudgeted(newRequests, toMigrate, machines, budget);
 
     m_lastReward = -m_lastCost;
     m_lastState = state;
@@ -90,6 +90,7 @@ QWidget *ILPDQNStrategy::createConfigWidget(QWidget *parent)
         auto layout = new QFormLayout(m_configWidget);
 
         auto gapSpin = new QDoubleSpinBox(m_configWidget);
+        gapSpin->setDecimals(4);
         gapSpin->setRange(0.00, 1.00);
         gapSpin->setSingleStep(0.001);
         gapSpin->setValue(m_gap);
@@ -174,84 +175,28 @@ std::vector<double> ILPDQNStrategy::ComputeState()
 {
     std::vector<double> state(20, 0.0);
 
-    auto machines = m_dataCenter->getPhysicalMachines();
-
-    // Compute the active VM count
-    int activeVMs = 0;
-    for (auto &machine : machines)
-    {
-        activeVMs += machine.getVirtualMachines().size();
-    }
-    state[0] = activeVMs;
-
-    // Compute the active PM count
-    int activePMs = 0;
-    for (auto &machine : machines)
-    {
-        if (machine.isTurnedOn())
-        {
-            activePMs++;
-        }
-    }
-    state[1] = activePMs;
-
-    // Compute the average utilizations and standard deviations
-    std::vector<double> cpuUtilizations;
-    std::vector<double> ramUtilizations;
-    std::vector<double> diskUtilizations;
-    std::vector<double> bwUtilizations;
-
-    for (auto &machine : machines)
-    {
-        if (machine.isTurnedOn())
-        {
-            cpuUtilizations.push_back(machine.getUtilization().cpu);
-            ramUtilizations.push_back(machine.getUtilization().ram);
-            diskUtilizations.push_back(machine.getUtilization().disk);
-            bwUtilizations.push_back(machine.getUtilization().bandwidth);
-        }
-    }
-
-    state[2] = cpuUtilizations.size() > 0 ? std::accumulate(cpuUtilizations.begin(), cpuUtilizations.end(), 0.0) / cpuUtilizations.size() : 0.0;
-
-    state[3] = cpuUtilizations.size() > 0 ? std::sqrt(std::accumulate(cpuUtilizations.begin(), cpuUtilizations.end(), 0.0, [state](double acc, double val)
-                                                                      { return acc + (val - state[2]) * (val - state[2]); }) /
-                                                      cpuUtilizations.size())
-                                          : 0.0;
-
-    state[4] = ramUtilizations.size() > 0 ? std::accumulate(ramUtilizations.begin(), ramUtilizations.end(), 0.0) / ramUtilizations.size() : 0.0;
-
-    state[5] = ramUtilizations.size() > 0 ? std::sqrt(std::accumulate(ramUtilizations.begin(), ramUtilizations.end(), 0.0, [state](double acc, double val)
-                                                                      { return acc + (val - state[4]) * (val - state[4]); }) /
-                                                      ramUtilizations.size())
-                                          : 0.0;
-
-    state[6] = diskUtilizations.size() > 0 ? std::accumulate(diskUtilizations.begin(), diskUtilizations.end(), 0.0) / diskUtilizations.size() : 0.0;
-
-    state[7] = diskUtilizations.size() > 0 ? std::sqrt(std::accumulate(diskUtilizations.begin(), diskUtilizations.end(), 0.0, [state](double acc, double val)
-                                                                       { return acc + (val - state[6]) * (val - state[6]); }) /
-                                                       diskUtilizations.size())
-                                           : 0.0;
-
-    state[8] = bwUtilizations.size() > 0 ? std::accumulate(bwUtilizations.begin(), bwUtilizations.end(), 0.0) / bwUtilizations.size() : 0.0;
-
-    state[9] = bwUtilizations.size() > 0 ? std::sqrt(std::accumulate(bwUtilizations.begin(), bwUtilizations.end(), 0.0, [state](double acc, double val)
-                                                                     { return acc + (val - state[8]) * (val - state[8]); }) /
-                                                     bwUtilizations.size())
-                                         : 0.0;
-
-    // Compute the bins for CPU utilizations in PMs with 20% increments
-    std::vector<int> cpuBins(5, 0);
-    for (auto &machine : machines)
-    {
-        if (machine.isTurnedOn())
-        {
-            int bin = std::min(4, static_cast<int>(machine.getUtilization().cpu / 20.0));
-            cpuBins[bin]++;
-        }
-    }
-
-    for (int i = 0; i < 5; ++i)
+    // All fleet features are maintained incrementally by the data center
+    const FleetStatistics &fleet = m_dataCenter->getFleetStatistics();
+
+    // Active VM and PM counts
+    state[0] = fleet.getVMCount();
+    state[1] = fleet.getTurnedOnMachineCount();
+
+    // Average utilizations and standard deviations
+    Resources mean = fleet.getMeanUtilization();
+    Resources stddev = fleet.getUtilizationStdDev();
+    state[2] = mean.cpu;
+    state[3] = stddev.cpu;
+    state[4] = mean.ram;
+    state[5] = stddev.ram;
+    state[6] = mean.disk;
+    state[7] = stddev.disk;
+    state[8] = mean.bandwidth;
+    state[9] = stddev.bandwidth;
+
+    // Bins for CPU utilizations in PMs with 20% increments
+    const auto &cpuBins = fleet.getCPUBins();
+    for (int i = 0; i < FleetStatistics::CPU_BIN_COUNT; ++i)
     {
         state[10 + i] = cpuBins[i];
     }
@@ -265,7 +210,7 @@ std::vector<double> ILPDQNStrategy::ComputeState()
     state[18] = m_dataCenter->getNumberOfSLAViolations();
 
     // Add the total power consumption of the PMs to the state
-    state[19] = m_dataCenter->getTotalPowerConsumption();
+    state[19] = fleet.getTotalPowerConsumption();
 
     return state;
 }
@@ -273,4 +218,10 @@ std::vector<double> ILPDQNStrategy::ComputeState()
 QString ILPDQNStrategy::name() const
 {
     return "ILP + DQN Strategy";
+}
+
+IPlacementStrategy *ILPDQNStrategy::clone() const
+{
+    // The agent learns from the live data center, a copy would train apart from it
+    return nullptr;
 }
\ No newline at end of file
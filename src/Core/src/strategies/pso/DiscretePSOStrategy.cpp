@@ -0,0 +1,473 @@
+#include "strategies/pso/DiscretePSOStrategy.h"
+#include "strategies/pso/PAPSOFitness.h"
+#include "logging/LogManager.h"
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <thread>
+
+DiscretePSOStrategy::DiscretePSOStrategy()
+{
+}
+
+DiscretePSOStrategy::~DiscretePSOStrategy()
+{
+}
+
+Results DiscretePSOStrategy::run(const std::vector<VirtualMachine *> &newRequests, const std::vector<VirtualMachine *> &toMigrate, const std::vector<PhysicalMachine> &machines)
+{
+    return runBudgeted(newRequests, toMigrate, machines, PlacementBudget{});
+}
+
+Results DiscretePSOStrategy::runBudgeted(const std::vector<VirtualMachine *> &newRequests, const std::vector<VirtualMachine *> &toMigrate, const std::vector<PhysicalMachine> &machines, const PlacementBudget &budget)
+{
+    BudgetTracker tracker(budget);
+    Results result;
+
+    std::vector<VirtualMachine *> allVMs;
+    allVMs.reserve(newRequests.size() + toMigrate.size());
+    allVMs.insert(allVMs.end(), newRequests.begin(), newRequests.end());
+    allVMs.insert(allVMs.end(), toMigrate.begin(), toMigrate.end());
+
+    const int numVMs = int(allVMs.size());
+    if (numVMs == 0 || machines.empty())
+    {
+        result.quality.seconds = tracker.elapsed();
+        return result;
+    }
+
+    m_candidateSelector.setExtraMachineCoefficient(m_extraMachineCoefficient);
+    m_candidates = m_candidateSelector.select(allVMs, machines);
+    const int numPMs = int(m_candidates.size());
+
+    auto context = std::make_shared<const PAPSOContext>(allVMs, m_candidates, m_w1, m_w2, m_utilThreshold);
+
+    // Largest VMs are moved first by the repair
+    m_vmOrder.resize(numVMs);
+    for (int i = 0; i < numVMs; ++i)
+        m_vmOrder[i] = i;
+    std::sort(m_vmOrder.begin(), m_vmOrder.end(), [&context](int a, int b)
+              { return context->demands[a].cpu > context->demands[b].cpu; });
+
+    // Every island owns its fitness state, islands never share mutable data
+    const int islandCount = std::max(1, m_islandCount);
+    std::vector<std::unique_ptr<PAPSOFitness>> fitnesses;
+    std::vector<Island> islands(islandCount);
+    for (int k = 0; k < islandCount; ++k)
+    {
+        fitnesses.push_back(std::make_unique<PAPSOFitness>(context));
+        fitnesses.back()->resetParticles(size_t(m_particlesPerIsland));
+        islands[k].fitness = fitnesses.back().get();
+        islands[k].rng.seed(m_rng());
+        initializeIsland(islands[k], numVMs, numPMs);
+    }
+
+    auto globalBest = [&islands]() -> const Particle &
+    {
+        const Particle *best = &islands.front().particles[islands.front().best];
+        for (auto &island : islands)
+        {
+            if (island.particles[island.best].bestValue < best->bestValue)
+                best = &island.particles[island.best];
+        }
+        return *best;
+    };
+
+    // Islands evolve in parallel for one migration interval, then pass their best around the ring
+    const int interval = std::max(1, m_migrationInterval);
+    const bool iterationCapped = budget.operations > 0 && budget.operations < size_t(m_maxIterations);
+    const int maxIterations = iterationCapped ? int(budget.operations) : m_maxIterations;
+    double bestValue = globalBest().bestValue;
+    int iterations = 0, stalledEpochs = 0;
+    bool budgetStop = false;
+    while (iterations < maxIterations)
+    {
+        if (tracker.cancelled() || tracker.remaining() <= 0)
+        {
+            budgetStop = true;
+            break;
+        }
+
+        int epochIterations = std::min(interval, maxIterations - iterations);
+        std::vector<int> done(islandCount, 0);
+        if (islandCount == 1)
+        {
+            done.front() = evolveIsland(islands.front(), epochIterations, numPMs, tracker);
+        }
+        else
+        {
+            std::vector<std::thread> threads;
+            for (int k = 0; k < islandCount; ++k)
+            {
+                threads.emplace_back([this, &islands, &done, &tracker, k, epochIterations, numPMs]()
+                                     { done[k] = evolveIsland(islands[k], epochIterations, numPMs, tracker); });
+            }
+            for (auto &thread : threads)
+            {
+                thread.join();
+            }
+            migrateBest(islands);
+        }
+
+        // An island stopped by the budget ends the run with the incumbent
+        int epochDone = *std::min_element(done.begin(), done.end());
+        iterations += epochDone;
+        budgetStop = epochDone < epochIterations;
+
+        double value = globalBest().bestValue;
+        stalledEpochs = (value < bestValue - 1e-12) ? 0 : stalledEpochs + 1;
+        bestValue = std::min(bestValue, value);
+        if (budgetStop || (m_stallEpochs > 0 && stalledEpochs >= m_stallEpochs))
+            break;
+    }
+
+    result.quality.objective = bestValue;
+    result.quality.iterations = iterations;
+    result.quality.complete = !budgetStop && !(iterationCapped && iterations >= maxIterations);
+
+    LogManager::instance().log(LogCategory::PLACEMENT, "Discrete PSO finished after " + std::to_string(iterations) + " iterations on " + std::to_string(islandCount) + " islands with fitness " + std::to_string(bestValue) + (budgetStop ? ", stopped by the budget" : ""));
+
+    // Map the candidate indices back to PM ids
+    const auto &best = globalBest().bestPosition;
+    for (size_t i = 0; i < newRequests.size(); ++i)
+    {
+        result.placementDecision.push_back({newRequests[i], m_candidates[best[i]]->getID()});
+    }
+    for (size_t j = 0; j < toMigrate.size(); ++j)
+    {
+        result.migrationDecision.push_back({toMigrate[j], m_candidates[best[newRequests.size() + j]]->getID()});
+    }
+
+    result.quality.seconds = tracker.elapsed();
+    return result;
+}
+
+void DiscretePSOStrategy::initializeIsland(Island &island, int numVMs, int numPMs)
+{
+    std::uniform_int_distribution<int> anyPM(0, numPMs - 1);
+
+    island.particles.assign(size_t(m_particlesPerIsland), Particle());
+    for (size_t p = 0; p < island.particles.size(); ++p)
+    {
+        auto &particle = island.particles[p];
+        particle.position.resize(numVMs);
+
+        // The first particle starts packed on one PM, the repair turns it into a best fit packing
+        for (int i = 0; i < numVMs; ++i)
+        {
+            particle.position[i] = (p == 0) ? 0 : anyPM(island.rng);
+            island.fitness->assign(p, i, particle.position[i]);
+        }
+        repairParticle(island, p, numPMs);
+
+        particle.bestPosition = particle.position;
+        particle.bestValue = island.fitness->score(p);
+        if (particle.bestValue < island.particles[island.best].bestValue || p == 0)
+            island.best = int(p);
+    }
+}
+
+int DiscretePSOStrategy::evolveIsland(Island &island, int iterations, int numPMs, const BudgetTracker &tracker)
+{
+    for (int it = 0; it < iterations; ++it)
+    {
+        if (tracker.cancelled() || tracker.remaining() <= 0)
+            return it;
+
+        // The island best may move during the sweep, guide every particle with the same one
+        std::vector<int> guide = island.particles[island.best].bestPosition;
+        for (size_t p = 0; p < island.particles.size(); ++p)
+        {
+            moveParticle(island, p, guide, numPMs);
+            repairParticle(island, p, numPMs);
+            if (evaluateParticle(island, p) < island.particles[island.best].bestValue)
+                island.best = int(p);
+        }
+    }
+    return iterations;
+}
+
+void DiscretePSOStrategy::moveParticle(Island &island, size_t index, const std::vector<int> &guide, int numPMs)
+{
+    auto &particle = island.particles[index];
+    std::uniform_real_distribution<double> dice(0.0, 1.0);
+    std::uniform_int_distribution<int> anyPM(0, numPMs - 1);
+
+    for (size_t i = 0; i < particle.position.size(); ++i)
+    {
+        // Each dimension follows the swarm, its own memory, a random PM, or stays
+        double r = dice(island.rng);
+        int pm = particle.position[i];
+        if (r < m_mutationProbability)
+            pm = anyPM(island.rng);
+        else if (r < m_mutationProbability + m_socialProbability)
+            pm = guide[i];
+        else if (r < m_mutationProbability + m_socialProbability + m_cognitiveProbability)
+            pm = particle.bestPosition[i];
+
+        if (pm != particle.position[i])
+        {
+            particle.position[i] = pm;
+            island.fitness->assign(index, int(i), pm);
+        }
+    }
+}
+
+void DiscretePSOStrategy::repairParticle(Island &island, size_t index, int numPMs)
+{
+    auto &particle = island.particles[index];
+    auto &fitness = *island.fitness;
+    const auto &context = fitness.getContext();
+
+    for (int vm : m_vmOrder)
+    {
+        int current = particle.position[vm];
+        if (canHost(fitness.getLoad(index, current), context.totals[current]))
+            continue; // its PM is within capacity
+
+        // Best fit among the PMs the particle already uses, then among the idle ones
+        const Resources &demand = context.demands[vm];
+        int chosen = -1;
+        bool chosenActive = false;
+        double chosenResidual = std::numeric_limits<double>::infinity();
+        for (int pm = 0; pm < numPMs; ++pm)
+        {
+            if (pm == current)
+                continue;
+
+            Resources load = fitness.getLoad(index, pm);
+            if (!canHost(load + demand, context.totals[pm]))
+                continue;
+
+            bool active = context.isActive(load);
+            double residual = context.totals[pm].cpu - load.cpu - demand.cpu;
+            if ((active && !chosenActive) || (active == chosenActive && residual < chosenResidual))
+            {
+                chosen = pm;
+                chosenActive = active;
+                chosenResidual = residual;
+            }
+        }
+
+        // Nothing fits, the placement repair of the data center has the last word
+        if (chosen < 0)
+            continue;
+
+        particle.position[vm] = chosen;
+        fitness.assign(index, vm, chosen);
+    }
+}
+
+double DiscretePSOStrategy::evaluateParticle(Island &island, size_t index)
+{
+    auto &particle = island.particles[index];
+    double value = island.fitness->score(index);
+    if (value < particle.bestValue)
+    {
+        particle.bestValue = value;
+        particle.bestPosition = particle.position;
+    }
+    return value;
+}
+
+void DiscretePSOStrategy::migrateBest(std::vector<Island> &islands)
+{
+    // Snapshot first, so an island does not forward what it has just received
+    std::vector<Particle> emigrants;
+    for (auto &island : islands)
+        emigrants.push_back(island.particles[island.best]);
+
+    for (size_t k = 0; k < islands.size(); ++k)
+    {
+        auto &target = islands[(k + 1) % islands.size()];
+        const auto &incoming = emigrants[k];
+
+        // The incoming best replaces the worst particle of the next island
+        size_t worst = 0;
+        for (size_t p = 1; p < target.particles.size(); ++p)
+        {
+            if (target.particles[p].bestValue > target.particles[worst].bestValue)
+                worst = p;
+        }
+
+        auto &particle = target.particles[worst];
+        for (size_t i = 0; i < incoming.bestPosition.size(); ++i)
+        {
+            particle.position[i] = incoming.bestPosition[i];
+            target.fitness->assign(worst, int(i), particle.position[i]);
+        }
+        particle.bestPosition = incoming.bestPosition;
+        particle.bestValue = incoming.bestValue;
+
+        if (particle.bestValue < target.particles[target.best].bestValue)
+            target.best = int(worst);
+    }
+}
+
+double DiscretePSOStrategy::getMigrationThreshold()
+{
+    return m_utilThreshold;
+}
+
+size_t DiscretePSOStrategy::getBundleSize()
+{
+    return m_bundleSize;
+}
+
+QWidget *DiscretePSOStrategy::createConfigWidget(QWidget *parent)
+{
+    if (!m_configWidget)
+    {
+        m_configWidget = new QWidget(parent);
+        auto layout = new QFormLayout(m_configWidget);
+
+        m_islandCountSpin = new QSpinBox(m_configWidget);
+        m_islandCountSpin->setRange(1, 64);
+        m_islandCountSpin->setValue(m_islandCount);
+        layout->addRow("Islands", m_islandCountSpin);
+
+        m_particlesPerIslandSpin = new QSpinBox(m_configWidget);
+        m_particlesPerIslandSpin->setRange(1, 1000);
+        m_particlesPerIslandSpin->setValue(m_particlesPerIsland);
+        layout->addRow("Particles per Island", m_particlesPerIslandSpin);
+
+        m_maxIterationsSpin = new QSpinBox(m_configWidget);
+        m_maxIterationsSpin->setRange(1, 10000);
+        m_maxIterationsSpin->setValue(m_maxIterations);
+        layout->addRow("Max Iterations", m_maxIterationsSpin);
+
+        m_migrationIntervalSpin = new QSpinBox(m_configWidget);
+        m_migrationIntervalSpin->setRange(1, 1000);
+        m_migrationIntervalSpin->setValue(m_migrationInterval);
+        layout->addRow("Migration Interval", m_migrationIntervalSpin);
+
+        m_stallEpochsSpin = new QSpinBox(m_configWidget);
+        m_stallEpochsSpin->setRange(0, 1000);
+        m_stallEpochsSpin->setSpecialValueText("Off");
+        m_stallEpochsSpin->setValue(m_stallEpochs);
+        layout->addRow("Stall Epochs", m_stallEpochsSpin);
+
+        m_cognitiveSpin = new QDoubleSpinBox(m_configWidget);
+        m_cognitiveSpin->setRange(0.0, 1.0);
+        m_cognitiveSpin->setSingleStep(0.05);
+        m_cognitiveSpin->setValue(m_cognitiveProbability);
+        layout->addRow("Personal Best Probability", m_cognitiveSpin);
+
+        m_socialSpin = new QDoubleSpinBox(m_configWidget);
+        m_socialSpin->setRange(0.0, 1.0);
+        m_socialSpin->setSingleStep(0.05);
+        m_socialSpin->setValue(m_socialProbability);
+        layout->addRow("Island Best Probability", m_socialSpin);
+
+        m_mutationSpin = new QDoubleSpinBox(m_configWidget);
+        m_mutationSpin->setRange(0.0, 1.0);
+        m_mutationSpin->setSingleStep(0.01);
+        m_mutationSpin->setValue(m_mutationProbability);
+        layout->addRow("Mutation Probability", m_mutationSpin);
+
+        m_w1Spin = new QDoubleSpinBox(m_configWidget);
+        m_w1Spin->setRange(0.0, 1.0);
+        m_w1Spin->setValue(m_w1);
+        layout->addRow("W1", m_w1Spin);
+
+        m_w2Spin = new QDoubleSpinBox(m_configWidget);
+        m_w2Spin->setRange(0.0, 1.0);
+        m_w2Spin->setValue(m_w2);
+        layout->addRow("W2", m_w2Spin);
+
+        m_utilThresholdSpin = new QDoubleSpinBox(m_configWidget);
+        m_utilThresholdSpin->setRange(0.0, 1.0);
+        m_utilThresholdSpin->setValue(m_utilThreshold);
+        layout->addRow("Utilization Threshold", m_utilThresholdSpin);
+
+        m_extraMachineCoefficientSpin = new QDoubleSpinBox(m_configWidget);
+        m_extraMachineCoefficientSpin->setRange(0.0, 10.0);
+        m_extraMachineCoefficientSpin->setSingleStep(0.1);
+        m_extraMachineCoefficientSpin->setValue(m_extraMachineCoefficient);
+        layout->addRow("Extra Machine Coefficient", m_extraMachineCoefficientSpin);
+
+        m_bundleSizeSpin = new QSpinBox(m_configWidget);
+        m_bundleSizeSpin->setRange(1, 1000);
+        m_bundleSizeSpin->setValue(int(m_bundleSize));
+        layout->addRow("Bundle Size", m_bundleSizeSpin);
+
+        m_configWidget->setLayout(layout);
+    }
+    return m_configWidget;
+}
+
+void DiscretePSOStrategy::applyConfigFromUI()
+{
+    if (m_islandCountSpin && m_particlesPerIslandSpin && m_maxIterationsSpin && m_migrationIntervalSpin &&
+        m_stallEpochsSpin && m_cognitiveSpin && m_socialSpin && m_mutationSpin && m_w1Spin && m_w2Spin &&
+        m_utilThresholdSpin && m_extraMachineCoefficientSpin && m_bundleSizeSpin)
+    {
+        m_islandCount = m_islandCountSpin->value();
+        m_particlesPerIsland = m_particlesPerIslandSpin->value();
+        m_maxIterations = m_maxIterationsSpin->value();
+        m_migrationInterval = m_migrationIntervalSpin->value();
+        m_stallEpochs = m_stallEpochsSpin->value();
+        m_cognitiveProbability = m_cognitiveSpin->value();
+        m_socialProbability = m_socialSpin->value();
+        m_mutationProbability = m_mutationSpin->value();
+        m_w1 = m_w1Spin->value();
+        m_w2 = m_w2Spin->value();
+        m_utilThreshold = m_utilThresholdSpin->value();
+        m_extraMachineCoefficient = m_extraMachineCoefficientSpin->value();
+        m_bundleSize = size_t(m_bundleSizeSpin->value());
+    }
+}
+
+QString DiscretePSOStrategy::name() const
+{
+    return "Discrete Island PSO";
+}
+
+IPlacementStrategy *DiscretePSOStrategy::clone() const
+{
+    auto *copy = new DiscretePSOStrategy();
+    copy->m_islandCount = m_islandCount;
+    copy->m_particlesPerIsland = m_particlesPerIsland;
+    copy->m_maxIterations = m_maxIterations;
+    copy->m_migrationInterval = m_migrationInterval;
+    copy->m_stallEpochs = m_stallEpochs;
+    copy->m_cognitiveProbability = m_cognitiveProbability;
+    copy->m_socialProbability = m_socialProbability;
+    copy->m_mutationProbability = m_mutationProbability;
+    copy->m_w1 = m_w1;
+    copy->m_w2 = m_w2;
+    copy->m_utilThreshold = m_utilThreshold;
+    copy->m_extraMachineCoefficient = m_extraMachineCoefficient;
+    copy->m_bundleSize = m_bundleSize;
+    return copy;
+}
+
+QWidget *DiscretePSOStrategy::createStatusWidget(QWidget *parent)
+{
+    if (!m_statusWidget)
+    {
+        m_statusWidget = new QWidget(parent);
+        auto layout = new QFormLayout(m_statusWidget);
+
+        auto islandsLabel = new QLabel("Islands: " + QString::number(m_islandCount) + " x " + QString::number(m_particlesPerIsland) + " particles", m_statusWidget);
+        layout->addRow(islandsLabel);
+
+        auto iterationsLabel = new QLabel("Max Iterations: " + QString::number(m_maxIterations), m_statusWidget);
+        layout->addRow(iterationsLabel);
+
+        auto migrationLabel = new QLabel("Migration Interval: " + QString::number(m_migrationInterval), m_statusWidget);
+        layout->addRow(migrationLabel);
+
+        auto probabilitiesLabel = new QLabel("Personal / Island / Mutation: " + QString::number(m_cognitiveProbability) + " / " + QString::number(m_socialProbability) + " / " + QString::number(m_mutationProbability), m_statusWidget);
+        layout->addRow(probabilitiesLabel);
+
+        auto utilThresholdLabel = new QLabel("Utilization Threshold: " + QString::number(m_utilThreshold), m_statusWidget);
+        layout->addRow(utilThresholdLabel);
+
+        auto bundleSizeLabel = new QLabel("Bundle Size: " + QString::number(m_bundleSize), m_statusWidget);
+        layout->addRow(bundleSizeLabel);
+
+        m_statusWidget->setLayout(layout);
+    }
+    return m_statusWidget;
+}
\ No newline at end of file
@@ -0,0 +1,115 @@
+#include "strategies/pso/PAPSOFitness.h"
+#include <algorithm>
+#include <cmath>
+
+PAPSOContext::PAPSOContext(const std::vector<VirtualMachine *> &vms, const std::vector<const PhysicalMachine *> &pms, double w1, double w2, double utilThreshold)
+    : w1(w1), w2(w2), utilThreshold(utilThreshold)
+{
+    demands.reserve(vms.size());
+    for (auto *vm : vms)
+        demands.push_back(vm->getTotalRequestedResources());
+
+    baseLoads.reserve(pms.size());
+    totals.reserve(pms.size());
+    for (auto *pm : pms)
+    {
+        baseLoads.push_back(pm->getUsed());
+        totals.push_back(pm->getTotal());
+
+        int id = int(baseLoads.size()) - 1;
+        if (isActive(baseLoads.back()))
+            baseActiveCount++;
+        if (isOverloaded(id, baseLoads.back()))
+            baseOverloadedCount++;
+    }
+}
+
+void PAPSOFitness::resetParticles(size_t count)
+{
+    m_particles.assign(count, ParticleState());
+    for (auto &state : m_particles)
+    {
+        state.assignment.assign(m_context->demands.size(), -1);
+        state.touched.reserve(2 * m_context->demands.size());
+        state.activeCount = m_context->baseActiveCount;
+        state.overloadedCount = m_context->baseOverloadedCount;
+    }
+}
+
+void PAPSOFitness::assign(size_t particle, int vm, int pm)
+{
+    auto &state = m_particles[particle];
+    int oldPm = state.assignment[vm];
+    if (oldPm == pm)
+        return;
+
+    const Resources &demand = m_context->demands[vm];
+    if (oldPm >= 0)
+        change(state, oldPm, demand, -1);
+    change(state, pm, demand, 1);
+    state.assignment[vm] = pm;
+}
+
+void PAPSOFitness::change(ParticleState &state, int pm, const Resources &demand, int direction) const
+{
+    const auto &ctx = *m_context;
+    auto it = state.touched.find(pm);
+    if (it == state.touched.end())
+        it = state.touched.emplace(pm, TouchedPM{ctx.baseLoads[pm], 0}).first;
+
+    auto &entry = it->second;
+    state.activeCount -= ctx.isActive(entry.load);
+    state.overloadedCount -= ctx.isOverloaded(pm, entry.load);
+
+    entry.vmCount += direction;
+    if (entry.vmCount == 0)
+        entry.load = ctx.baseLoads[pm]; // exact baseline, no accumulated rounding
+    else if (direction > 0)
+        entry.load += demand;
+    else
+        entry.load -= demand;
+
+    state.activeCount += ctx.isActive(entry.load);
+    state.overloadedCount += ctx.isOverloaded(pm, entry.load);
+}
+
+Resources PAPSOFitness::getLoad(size_t particle, int pm) const
+{
+    const auto &touched = m_particles[particle].touched;
+    auto it = touched.find(pm);
+    return it != touched.end() ? it->second.load : m_context->baseLoads[pm];
+}
+
+double PAPSOFitness::score(size_t particle) const
+{
+    return score(m_particles[particle].activeCount, m_particles[particle].overloadedCount);
+}
+
+double PAPSOFitness::score(int activeCount, int overloadedCount) const
+{
+    const double numPMs = double(m_context->totals.size());
+    return m_context->w1 * (activeCount / numPMs) + m_context->w2 * (overloadedCount / numPMs);
+}
+
+double PAPSOFitness::evaluate(const std::vector<int> &assignment) const
+{
+    const auto &ctx = *m_context;
+
+    std::unordered_map<int, Resources> loads;
+    for (size_t i = 0; i < assignment.size(); ++i)
+    {
+        int pm = assignment[i];
+        auto it = loads.find(pm);
+        if (it == loads.end())
+            it = loads.emplace(pm, ctx.baseLoads[pm]).first;
+        it->second += ctx.demands[i];
+    }
+
+    int activeCount = ctx.baseActiveCount, overloadedCount = ctx.baseOverloadedCount;
+    for (auto &[pm, load] : loads)
+    {
+        activeCount += int(ctx.isActive(load)) - int(ctx.isActive(ctx.baseLoads[pm]));
+        overloadedCount += int(ctx.isOverloaded(pm, load)) - int(ctx.isOverloaded(pm, ctx.baseLoads[pm]));
+    }
+    return score(activeCount, overloadedCount);
+}
@@ -1,107 +1,74 @@
 #include "strategies/pso/PAPSOStrategy.h"
 #include "logging/LogManager.h"
+#include "strategies/pso/PAPSOFitness.h"
 #include "pso-cpp/psocpp.h"
+#include <memory>
+#include <numeric>
 
 struct PAPSOObjective
 {
-    // these will be set before PSO runs
-    static const std::vector<VirtualMachine *> *vmsPtr;
-    static const std::vector<PhysicalMachine> *pmsPtr;
-    static double w1, w2;
-    static double utilThreshold;
+    std::shared_ptr<PAPSOFitness> fitness;
 
     PAPSOObjective() = default;
+    explicit PAPSOObjective(std::shared_ptr<PAPSOFitness> fitness) : fitness(std::move(fitness)) {}
 
+    // Incremental evaluation, psocpp passes the particle index and each particle is evaluated by one thread
     template <typename Derived>
-    double operator()(const Eigen::MatrixBase<Derived> &x) const
+    double operator()(const Eigen::MatrixBase<Derived> &x, pso::Index particle)
     {
-        const auto &vms = *vmsPtr;
-        const auto &pms = *pmsPtr;
-        const int numPMs = int(pms.size());
-        const int numVMs = int(vms.size());
-
-        std::vector<Resources> loads(numPMs);
-        std::vector<Resources> totals(numPMs);
-        for (int i = 0; i < (int)pms.size(); ++i)
+        const int numPMs = int(fitness->getContext().totals.size());
+        for (int i = 0; i < int(x.size()); ++i)
         {
-            loads[i] = pms[i].getUsed();
-            totals[i] = pms[i].getTotal();
+            int pm = std::clamp(int(std::round(x(i))), 0, numPMs - 1);
+            fitness->assign(size_t(particle), i, pm);
         }
+        return fitness->score(size_t(particle));
+    }
 
-        size_t numTurnedOnInitially = 0;
-        for (auto &pm : pms)
-        {
-            if (pm.isTurnedOn())
-                numTurnedOnInitially++;
-        }
+    template <typename Derived>
+    double operator()(const Eigen::MatrixBase<Derived> &x) const
+    {
+        return fitness->evaluate(decode(x, int(fitness->getContext().totals.size())));
+    }
 
-        for (int i = 0; i < numVMs; ++i)
-        {
-            int pm = int(std::round(x(i)));
-            pm = std::clamp(pm, 0, numPMs - 1);
+    template <typename Derived>
+    static std::vector<int> decode(const Eigen::MatrixBase<Derived> &x, int numPMs)
+    {
+        std::vector<int> assignment(x.size());
+        for (int i = 0; i < int(x.size()); ++i)
+            assignment[i] = std::clamp(int(std::round(x(i))), 0, numPMs - 1);
+        return assignment;
+    }
+};
 
-            loads[pm] += vms[i]->getTotalRequestedResources();
-        }
+// Stops the swarm once gbest has not improved for a number of iterations, or the budget ran out
+struct PAPSOStallCallback
+{
+    using Matrix = Eigen::MatrixXd;
+    using Vector = Eigen::VectorXd;
 
-        // count active vs overloaded
-        int activeCount = 0, overloadedCount = 0;
-        for (int pm = 0; pm < numPMs; ++pm)
+    pso::Index stallIterations{0}; // 0 never stops
+    double bestValue{std::numeric_limits<double>::infinity()};
+    pso::Index lastImprovement{0};
+    const BudgetTracker *tracker{nullptr};
+    bool *budgetStop{nullptr}; // set when the deadline or the cancellation ended the run
+
+    bool operator()(const pso::Index iteration, const Matrix &, const Vector &bestFvals, const pso::Index gbest)
+    {
+        if (bestFvals(gbest) < bestValue - 1e-12)
         {
-            bool isActive = loads[pm].cpu > 0.0;
-            Resources utilization = loads[pm] / pms[pm].getTotal();
-            bool isOverloaded = (utilization.cpu > utilThreshold || utilization.ram > utilThreshold || utilization.disk > utilThreshold || utilization.bandwidth > utilThreshold || utilization.fpga > utilThreshold);
-            if (isActive)
-                activeCount++;
-            if (isOverloaded)
-                overloadedCount++;
+            bestValue = bestFvals(gbest);
+            lastImprovement = iteration;
         }
-
-        double fracActive = double(activeCount) / numPMs;
-        double fracOverload = double(overloadedCount) / numPMs;
-
-        double result = w1 * fracActive + w2 * fracOverload;
-
-        /*
-        for (int pm = 0; pm < (int)pms.size(); ++pm)
+        if (tracker && (tracker->cancelled() || tracker->remaining() <= 0))
         {
-            const double penalty = 0;
-            if (loads[pm].cpu > totals[pm].cpu)
-            {
-                result += (penalty * (loads[pm].cpu - totals[pm].cpu) / totals[pm].cpu);
-            }
-            if (loads[pm].ram > totals[pm].ram)
-            {
-                result += (penalty * (loads[pm].ram - totals[pm].ram) / totals[pm].ram);
-            }
-            if (loads[pm].disk > totals[pm].disk)
-            {
-                result += (penalty * (loads[pm].disk - totals[pm].disk) / totals[pm].disk);
-            }
-            if (loads[pm].bandwidth > totals[pm].bandwidth)
-            {
-                result += (penalty * (loads[pm].bandwidth - totals[pm].bandwidth) / totals[pm].bandwidth);
-            }
-            if (loads[pm].fpga > totals[pm].fpga)
-            {
-                result += (penalty * (loads[pm].fpga - totals[pm].fpga) / totals[pm].fpga);
-            }
+            *budgetStop = true;
+            return false;
         }
-
-        size_t newMachines = activeCount - numTurnedOnInitially;
-        result += newMachines * 0;
-        */
-
-        return result;
+        return stallIterations <= 0 || iteration - lastImprovement < stallIterations;
     }
 };
 
-// Definition of static members
-const std::vector<VirtualMachine *> *PAPSOObjective::vmsPtr = nullptr;
-const std::vector<PhysicalMachine> *PAPSOObjective::pmsPtr = nullptr;
-double PAPSOObjective::w1 = 0.5;
-double PAPSOObjective::w2 = 0.5;
-double PAPSOObjective::utilThreshold = 0.5;
-
 PAPSOStrategy::PAPSOStrategy(double w1, double w2,
                              int swarmSize, int maxIterations,
                              double inertiaMin, double inertiaMax,
@@ -119,6 +86,15 @@ Results PAPSOStrategy::run(const std::vector<VirtualMachine *> &newRequests,
                            const std::vector<VirtualMachine *> &toMigrate,
                            const std::vector<PhysicalMachine> &machines)
 {
+    return runBudgeted(newRequests, toMigrate, machines, PlacementBudget{});
+}
+
+Results PAPSOStrategy::runBudgeted(const std::vector<VirtualMachine *> &newRequests,
+                                   const std::vector<VirtualMachine *> &toMigrate,
+                                   const std::vector<PhysicalMachine> &machines,
+                                   const PlacementBudget &budget)
+{
+    BudgetTracker tracker(budget);
     Results result;
 
     // 1) Combine all VMs
@@ -128,48 +104,80 @@ Results PAPSOStrategy::run(const std::vector<VirtualMachine *> &newRequests,
     allVMs.insert(allVMs.end(), toMigrate.begin(), toMigrate.end());
 
     const int numVMs = int(allVMs.size());
-    const int numPMs = int(machines.size());
-    if (numVMs == 0 || numPMs == 0)
+    if (numVMs == 0 || machines.empty())
         return result;
 
-    // 2) Prepare the static pointers & weights for the functor
-    PAPSOObjective::vmsPtr = &allVMs;
-    PAPSOObjective::pmsPtr = &machines;
-    PAPSOObjective::w1 = m_w1;
-    PAPSOObjective::w2 = m_w2;
-    PAPSOObjective::utilThreshold = m_utilThreshold;
+    // 2) Restrict the search to the candidate PMs, the swarm works on indices into m_candidates
+    chooseCandidates(allVMs, machines);
+    const int numPMs = int(m_candidates.size());
+
+    // 3) Precompute the inputs of the objective once for the whole run
+    auto context = std::make_shared<const PAPSOContext>(allVMs, m_candidates, m_w1, m_w2, m_utilThreshold);
+    auto fitness = std::make_shared<PAPSOFitness>(context);
+    fitness->resetParticles(size_t(m_swarmSize));
 
-    // 3) Build bounds: each of the numVMs dims in [0, numPMs-1]
+    // Build bounds: each of the numVMs dims in [0, numPMs-1]
     Eigen::MatrixXd bounds(2, numVMs);
     bounds.row(0).setZero();               // lower = 0
     bounds.row(1).setConstant(numPMs - 1); // upper = numPMs-1
 
     // 4) Instantiate PSO optimizer
-    //    Template: <T, Functor, InertiaStrategy>
+    //    Template: <T, Functor, InertiaStrategy, Callback>
     using Inertia = pso::LinearDecrease<double>;
-    pso::ParticleSwarmOptimization<double, PAPSOObjective, Inertia> opt;
-
-    // 5) Configure PSO stopping criteria & performance
-    opt.setMaxIterations(m_maxIterations);
-    opt.setThreads(0);   // single-threaded
-    opt.setVerbosity(0); // silent
+    pso::ParticleSwarmOptimization<double, PAPSOObjective, Inertia, PAPSOStallCallback> opt;
+    opt.setObjective(PAPSOObjective(fitness));
+
+    bool budgetStop = false;
+    PAPSOStallCallback stall;
+    stall.stallIterations = m_stallIterations;
+    stall.tracker = &tracker;
+    stall.budgetStop = &budgetStop;
+    opt.setCallback(stall);
+
+    // 5) Configure PSO stopping criteria & performance, the operation budget counts swarm iterations
+    bool iterationCapped = budget.operations > 0 && budget.operations < size_t(m_maxIterations);
+    opt.setMaxIterations(iterationCapped ? int(budget.operations) : m_maxIterations);
+    opt.setThreads(m_threads); // 0 uses every core
+    opt.setVerbosity(0);       // silent
     opt.setPhiParticles(m_c1);
     opt.setPhiGlobal(m_c2);
     opt.setInertiaWeightStrategy(pso::LinearDecrease<double>(m_inertiaMin, m_inertiaMax));
     opt.setMinFunctionChange(-1);
     opt.setMinParticleChange(-1);
     opt.setMaxVelocity(m_maxVelocity);
+    opt.setSeed(m_rng()); // reproducible runs
+
+    // 6) Run PSO, a single candidate leaves nothing to search
+    std::vector<int> assignment(numVMs, 0);
+    if (numPMs > 1)
+    {
+        auto psoResult = [&]()
+        {
+            if (!m_warmStart)
+                return opt.minimize(bounds, m_swarmSize);
 
-    // 6) Run PSO
-    auto psoResult = opt.minimize(bounds, m_swarmSize);
+            Eigen::MatrixXd particles = initializeSwarm(buildSeeds(*context, allVMs), numPMs);
+            return opt.minimize(bounds, particles);
+        }();
+        assignment = PAPSOObjective::decode(psoResult.xval, numPMs);
 
-    // 7) Decode best solution: round each dim to int PM index
-    std::vector<int> assignment(numVMs);
-    for (int i = 0; i < numVMs; ++i)
+        result.quality.objective = psoResult.fval;
+        result.quality.iterations = psoResult.iterations;
+        result.quality.complete = !budgetStop && !(iterationCapped && psoResult.iterations >= pso::Index(budget.operations));
+
+        LogManager::instance().log(LogCategory::PLACEMENT, "PAPSO finished after " + std::to_string(psoResult.iterations) + " iterations with fitness " + std::to_string(psoResult.fval));
+    }
+    else
+    {
+        result.quality.objective = fitness->evaluate(assignment);
+    }
+
+    // 7) Map the candidate indices back to PM ids
+    for (auto &pm : assignment)
     {
-        int pm = int(std::round(psoResult.xval(i)));
-        assignment[i] = std::clamp(pm, 0, numPMs - 1);
+        pm = m_candidates[pm]->getID();
     }
+    rememberBest(allVMs, assignment);
 
     // 8) Fill Results
     for (size_t i = 0; i < newRequests.size(); ++i)
@@ -182,9 +190,131 @@ Results PAPSOStrategy::run(const std::vector<VirtualMachine *> &newRequests,
                                             assignment[int(newRequests.size()) + int(j)]});
     }
 
+    result.quality.seconds = tracker.elapsed();
     return result;
 }
 
+void PAPSOStrategy::chooseCandidates(const std::vector<VirtualMachine *> &vms, const std::vector<PhysicalMachine> &machines)
+{
+    if (m_useCandidateSet)
+    {
+        m_candidateSelector.setExtraMachineCoefficient(m_extraMachineCoefficient);
+        m_candidates = m_candidateSelector.select(vms, machines);
+        return;
+    }
+
+    m_candidates.clear();
+    for (auto &machine : machines)
+        m_candidates.push_back(&machine);
+}
+
+std::vector<std::vector<int>> PAPSOStrategy::buildSeeds(const PAPSOContext &context, const std::vector<VirtualMachine *> &vms) const
+{
+    std::vector<std::vector<int>> seeds;
+    seeds.push_back(greedySeed(context, false)); // first fit decreasing
+    seeds.push_back(greedySeed(context, true));  // best fit decreasing
+
+    if (m_previousBest.empty())
+        return seeds;
+
+    // Previous gbest mapped onto the current candidates: same PM for VMs of the previous bundle
+    // (migrations), the PM of the same bundle position otherwise, the first fit seed where that PM is no candidate
+    std::unordered_map<int, int> candidateIndex;
+    for (size_t i = 0; i < m_candidates.size(); ++i)
+        candidateIndex[m_candidates[i]->getID()] = int(i);
+
+    std::vector<int> previous(vms.size());
+    for (size_t i = 0; i < vms.size(); ++i)
+    {
+        auto byVM = m_previousBestByVM.find(vms[i]->getID());
+        int pmId = (byVM != m_previousBestByVM.end()) ? byVM->second : m_previousBest[i % m_previousBest.size()];
+        auto it = candidateIndex.find(pmId);
+        previous[i] = (it != candidateIndex.end()) ? it->second : seeds.front()[i];
+    }
+    seeds.push_back(std::move(previous));
+
+    return seeds;
+}
+
+std::vector<int> PAPSOStrategy::greedySeed(const PAPSOContext &context, bool bestFit) const
+{
+    const int numVMs = int(context.demands.size());
+    const int numPMs = int(context.totals.size());
+
+    std::vector<int> order(numVMs);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&context](int a, int b)
+              { return context.demands[a].cpu > context.demands[b].cpu; });
+
+    // Pack under the utilization threshold first, the objective counts everything above it as overloaded
+    std::vector<Resources> loads = context.baseLoads;
+    std::vector<int> assignment(numVMs, 0);
+    for (int vm : order)
+    {
+        const Resources &demand = context.demands[vm];
+        int chosen = -1;
+        for (double limit : {m_utilThreshold, 1.0})
+        {
+            double bestResidual = std::numeric_limits<double>::infinity();
+            for (int pm = 0; pm < numPMs; ++pm)
+            {
+                if (!canHost(loads[pm] + demand, context.totals[pm] * limit))
+                    continue;
+
+                double residual = context.totals[pm].cpu * limit - loads[pm].cpu - demand.cpu;
+                if (!bestFit)
+                {
+                    chosen = pm;
+                    break;
+                }
+                if (residual < bestResidual)
+                {
+                    bestResidual = residual;
+                    chosen = pm;
+                }
+            }
+            if (chosen >= 0)
+                break;
+        }
+
+        // Nothing fits, leave it to the swarm and the repair stage
+        assignment[vm] = std::max(chosen, 0);
+        loads[assignment[vm]] += demand;
+    }
+    return assignment;
+}
+
+Eigen::MatrixXd PAPSOStrategy::initializeSwarm(const std::vector<std::vector<int>> &seeds, int numPMs)
+{
+    const int numVMs = int(seeds.front().size());
+    Eigen::MatrixXd particles(numVMs, m_swarmSize);
+
+    std::uniform_int_distribution<int> anyPM(0, numPMs - 1);
+    std::normal_distribution<double> jitter(0.0, 0.5);
+    for (int p = 0; p < m_swarmSize; ++p)
+    {
+        const auto &seed = seeds[p % seeds.size()];
+        for (int i = 0; i < numVMs; ++i)
+        {
+            if (p < int(seeds.size()))
+                particles(i, p) = seed[i]; // the seeds themselves
+            else if (randomDouble(0.0, 1.0) < m_seedPerturbation)
+                particles(i, p) = anyPM(m_rng);
+            else
+                particles(i, p) = seed[i] + jitter(m_rng);
+        }
+    }
+    return particles;
+}
+
+void PAPSOStrategy::rememberBest(const std::vector<VirtualMachine *> &vms, const std::vector<int> &pmIds)
+{
+    m_previousBest = pmIds;
+    m_previousBestByVM.clear();
+    for (size_t i = 0; i < vms.size(); ++i)
+        m_previousBestByVM[vms[i]->getID()] = pmIds[i];
+}
+
 double PAPSOStrategy::getMigrationThreshold()
 {
     return m_utilThreshold;
@@ -252,6 +382,32 @@ QWidget *PAPSOStrategy::createConfigWidget(QWidget *parent)
         m_maxVelocitySpin->setValue(m_maxVelocity);
         layout->addRow("Max Velocity", m_maxVelocitySpin);
 
+        m_threadsSpin = new QSpinBox(m_configWidget);
+        m_threadsSpin->setRange(0, 256);
+        m_threadsSpin->setSpecialValueText("Auto");
+        m_threadsSpin->setValue(m_threads);
+        layout->addRow("Threads", m_threadsSpin);
+
+        m_useCandidateSetCheck = new QCheckBox("Search candidate PMs only", m_configWidget);
+        m_useCandidateSetCheck->setChecked(m_useCandidateSet);
+        layout->addRow(m_useCandidateSetCheck);
+
+        m_extraMachineCoefficientSpin = new QDoubleSpinBox(m_configWidget);
+        m_extraMachineCoefficientSpin->setRange(0.0, 10.0);
+        m_extraMachineCoefficientSpin->setSingleStep(0.1);
+        m_extraMachineCoefficientSpin->setValue(m_extraMachineCoefficient);
+        layout->addRow("Extra Machine Coefficient", m_extraMachineCoefficientSpin);
+
+        m_warmStartCheck = new QCheckBox("Seed swarm from heuristics and the previous solution", m_configWidget);
+        m_warmStartCheck->setChecked(m_warmStart);
+        layout->addRow(m_warmStartCheck);
+
+        m_stallIterationsSpin = new QSpinBox(m_configWidget);
+        m_stallIterationsSpin->setRange(0, 1000);
+        m_stallIterationsSpin->setSpecialValueText("Off");
+        m_stallIterationsSpin->setValue(m_stallIterations);
+        layout->addRow("Stall Iterations", m_stallIterationsSpin);
+
         m_configWidget->setLayout(layout);
     }
     return m_configWidget;
@@ -261,7 +417,8 @@ void PAPSOStrategy::applyConfigFromUI()
 {
     if (m_w1Spin && m_w2Spin && m_swarmSizeSpin && m_maxIterationsSpin &&
         m_inertiaMinSpin && m_inertiaMaxSpin && m_c1Spin && m_c2Spin &&
-        m_utilThresholdSpin && m_maxVelocitySpin)
+        m_utilThresholdSpin && m_maxVelocitySpin && m_threadsSpin &&
+        m_useCandidateSetCheck && m_extraMachineCoefficientSpin && m_warmStartCheck && m_stallIterationsSpin)
     {
         m_w1 = m_w1Spin->value();
         m_w2 = m_w2Spin->value();
@@ -273,6 +430,11 @@ void PAPSOStrategy::applyConfigFromUI()
         m_c2 = m_c2Spin->value();
         m_utilThreshold = m_utilThresholdSpin->value();
         m_maxVelocity = m_maxVelocitySpin->value();
+        m_threads = m_threadsSpin->value();
+        m_useCandidateSet = m_useCandidateSetCheck->isChecked();
+        m_extraMachineCoefficient = m_extraMachineCoefficientSpin->value();
+        m_warmStart = m_warmStartCheck->isChecked();
+        m_stallIterations = m_stallIterationsSpin->value();
     }
 }
 
@@ -281,6 +443,19 @@ QString PAPSOStrategy::name() const
     return "PAPSO";
 }
 
+IPlacementStrategy *PAPSOStrategy::clone() const
+{
+    auto *copy = new PAPSOStrategy(m_w1, m_w2, m_swarmSize, m_maxIterations, m_inertiaMin, m_inertiaMax, m_c1, m_c2, m_maxVelocity);
+    copy->m_utilThreshold = m_utilThreshold;
+    copy->m_threads = m_threads;
+    copy->m_useCandidateSet = m_useCandidateSet;
+    copy->m_extraMachineCoefficient = m_extraMachineCoefficient;
+    copy->m_warmStart = m_warmStart;
+    copy->m_seedPerturbation = m_seedPerturbation;
+    copy->m_stallIterations = m_stallIterations;
+    return copy;
+}
+
 QWidget *PAPSOStrategy::createStatusWidget(QWidget *parent)
 {
     if (!m_statusWidget)
@@ -318,6 +493,18 @@ QWidget *PAPSOStrategy::createStatusWidget(QWidget *parent)
         auto maxVelocityLabel = new QLabel("Max Velocity: " + QString::number(m_maxVelocity), m_statusWidget);
         layout->addRow(maxVelocityLabel);
 
+        auto threadsLabel = new QLabel("Threads: " + (m_threads > 0 ? QString::number(m_threads) : QString("Auto")), m_statusWidget);
+        layout->addRow(threadsLabel);
+
+        auto candidateSetLabel = new QLabel("Candidate PMs: " + (m_useCandidateSet ? "On, extra coefficient " + QString::number(m_extraMachineCoefficient) : QString("Off")), m_statusWidget);
+        layout->addRow(candidateSetLabel);
+
+        auto warmStartLabel = new QLabel("Warm Start: " + QString(m_warmStart ? "On" : "Off"), m_statusWidget);
+        layout->addRow(warmStartLabel);
+
+        auto stallIterationsLabel = new QLabel("Stall Iterations: " + (m_stallIterations > 0 ? QString::number(m_stallIterations) : QString("Off")), m_statusWidget);
+        layout->addRow(stallIterationsLabel);
+
         m_statusWidget->setLayout(layout);
     }
     return m_statusWidget;
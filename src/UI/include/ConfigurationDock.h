@@ -7,6 +7,8 @@
 #include <QPushButton>
 #include <QLineEdit>
 #include <QFileDialog>
+#include <QCheckBox>
+#include <QDoubleSpinBox>
 #include "strategies/IPlacementStrategy.h"
 #include "ISimulationConfiguration.h"
 
@@ -28,6 +30,14 @@ private:
     void onStrategyResetClicked();
     void onOutputFileBrowseClicked();
     void onOutputFileApplyClicked();
+    void onMigrationPolicyChanged(int index);
+    void onBundleSchedulingApplyClicked();
+    void onEventBatchingToggled(bool checked);
+    void onAsyncPlacementApplyClicked();
+    void onPlacementDeadlineApplyClicked();
+    void onPlacementCacheToggled(bool checked);
+    void onConsolidationApplyClicked();
+    void onClusteringApplyClicked();
 
 private:
     ISimulationConfiguration *m_simulator{nullptr};
@@ -38,6 +48,34 @@ private:
     QPushButton *m_outputFileBrowseBtn{nullptr};
     QPushButton *m_outputFileApplyBtn{nullptr};
 
+    QComboBox *m_migrationPolicyCombo{nullptr};
+
+    QDoubleSpinBox *m_maxBundleWaitSpin{nullptr};
+    QCheckBox *m_adaptiveBundleCheck{nullptr};
+    QPushButton *m_bundleSchedulingApplyBtn{nullptr};
+    QSpinBox *m_minBundleSizeSpin{nullptr};
+    QSpinBox *m_maxBundleSizeSpin{nullptr};
+    QDoubleSpinBox *m_targetSolveTimeSpin{nullptr};
+
+    QCheckBox *m_eventBatchingCheck{nullptr};
+
+    QCheckBox *m_asyncPlacementCheck{nullptr};
+    QDoubleSpinBox *m_decisionLatencySpin{nullptr};
+    QPushButton *m_asyncPlacementApplyBtn{nullptr};
+
+    QDoubleSpinBox *m_placementDeadlineSpin{nullptr};
+    QPushButton *m_placementDeadlineApplyBtn{nullptr};
+
+    QCheckBox *m_placementCacheCheck{nullptr};
+
+    QDoubleSpinBox *m_consolidationIntervalSpin{nullptr};
+    QDoubleSpinBox *m_consolidationBudgetSpin{nullptr};
+    QPushButton *m_consolidationApplyBtn{nullptr};
+
+    QSpinBox *m_clusterSizeSpin{nullptr};
+    QComboBox *m_clusterStrategyCombo{nullptr};
+    QPushButton *m_clusteringApplyBtn{nullptr};
+
     QComboBox *m_strategyCombo{nullptr};
     QPushButton *m_strategyApplyBtn{nullptr};
     QPushButton *m_strategyResetBtn{nullptr};
@@ -27,6 +27,11 @@ private:
     QLabel *m_turnedOnMachineCountLabel;
     QLabel *m_currentStrategyLabel;
     QLabel *m_currentBundleSizeLabel;
+    QLabel *m_placementDelayLabel;
+    QLabel *m_arrivalRateLabel;
+    QLabel *m_placementCacheLabel;
+    QLabel *m_consolidationLabel;
+    QLabel *m_clusteringLabel;
     QTimer m_timer;
     QFormLayout *m_formLayout;
 
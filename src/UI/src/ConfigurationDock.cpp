@@ -50,6 +50,162 @@ void ConfigurationDock::createUI()
 
     m_formLayout->addRow(hboxOutputFile);
 
+    // Migration candidate selection
+    m_migrationPolicyCombo = new QComboBox(m_container);
+    for (auto &info : MigrationCandidateSet::availablePolicies())
+    {
+        m_migrationPolicyCombo->addItem(QString::fromStdString(info.displayName), static_cast<int>(info.policy));
+    }
+    m_migrationPolicyCombo->setCurrentIndex(m_migrationPolicyCombo->findData(static_cast<int>(m_simulator->getMigrationSelectionPolicy())));
+    connect(m_migrationPolicyCombo, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &ConfigurationDock::onMigrationPolicyChanged);
+    m_formLayout->addRow("Migration candidates:", m_migrationPolicyCombo);
+
+    // Bundle scheduling
+    auto hboxBundle = new QHBoxLayout();
+
+    m_maxBundleWaitSpin = new QDoubleSpinBox(m_container);
+    m_maxBundleWaitSpin->setRange(0.0, 86400.0);
+    m_maxBundleWaitSpin->setSingleStep(60.0);
+    m_maxBundleWaitSpin->setSuffix(" s");
+    m_maxBundleWaitSpin->setValue(m_simulator->getMaxBundleWait());
+    hboxBundle->addWidget(m_maxBundleWaitSpin);
+
+    m_adaptiveBundleCheck = new QCheckBox("Adaptive size", m_container);
+    m_adaptiveBundleCheck->setChecked(m_simulator->getBundleSizingMode() == BundleSizingMode::Adaptive);
+    hboxBundle->addWidget(m_adaptiveBundleCheck);
+
+    m_bundleSchedulingApplyBtn = new QPushButton("Apply", m_container);
+    connect(m_bundleSchedulingApplyBtn, &QPushButton::clicked, this, &ConfigurationDock::onBundleSchedulingApplyClicked);
+    hboxBundle->addWidget(m_bundleSchedulingApplyBtn);
+
+    m_formLayout->addRow("Max bundle wait:", hboxBundle);
+
+    // Adaptive bundle size, applied with the bundle scheduling
+    auto hboxAdaptive = new QHBoxLayout();
+
+    m_minBundleSizeSpin = new QSpinBox(m_container);
+    m_minBundleSizeSpin->setRange(1, 100000);
+    m_minBundleSizeSpin->setValue(static_cast<int>(m_simulator->getAdaptiveBundleMinSize()));
+    hboxAdaptive->addWidget(m_minBundleSizeSpin);
+
+    m_maxBundleSizeSpin = new QSpinBox(m_container);
+    m_maxBundleSizeSpin->setRange(1, 100000);
+    m_maxBundleSizeSpin->setValue(static_cast<int>(m_simulator->getAdaptiveBundleMaxSize()));
+    hboxAdaptive->addWidget(m_maxBundleSizeSpin);
+
+    m_targetSolveTimeSpin = new QDoubleSpinBox(m_container);
+    m_targetSolveTimeSpin->setRange(0.001, 3600.0);
+    m_targetSolveTimeSpin->setDecimals(3);
+    m_targetSolveTimeSpin->setSingleStep(0.1);
+    m_targetSolveTimeSpin->setSuffix(" s");
+    m_targetSolveTimeSpin->setValue(m_simulator->getTargetSolveTime());
+    hboxAdaptive->addWidget(m_targetSolveTimeSpin);
+
+    m_formLayout->addRow("Adaptive size (min / max / solve):", hboxAdaptive);
+
+    // Event batching
+    m_eventBatchingCheck = new QCheckBox("Process same-time events as one batch", m_container);
+    m_eventBatchingCheck->setChecked(m_simulator->isEventBatching());
+    connect(m_eventBatchingCheck, &QCheckBox::toggled, this, &ConfigurationDock::onEventBatchingToggled);
+    m_formLayout->addRow(m_eventBatchingCheck);
+
+    // Asynchronous placement
+    auto hboxAsync = new QHBoxLayout();
+
+    m_asyncPlacementCheck = new QCheckBox("Enabled", m_container);
+    m_asyncPlacementCheck->setChecked(m_simulator->isAsyncPlacement());
+    hboxAsync->addWidget(m_asyncPlacementCheck);
+
+    m_decisionLatencySpin = new QDoubleSpinBox(m_container);
+    m_decisionLatencySpin->setRange(0.0, 3600.0);
+    m_decisionLatencySpin->setSingleStep(1.0);
+    m_decisionLatencySpin->setSuffix(" s");
+    m_decisionLatencySpin->setValue(m_simulator->getDecisionLatency());
+    hboxAsync->addWidget(m_decisionLatencySpin);
+
+    m_asyncPlacementApplyBtn = new QPushButton("Apply", m_container);
+    connect(m_asyncPlacementApplyBtn, &QPushButton::clicked, this, &ConfigurationDock::onAsyncPlacementApplyClicked);
+    hboxAsync->addWidget(m_asyncPlacementApplyBtn);
+
+    m_formLayout->addRow("Async placement:", hboxAsync);
+
+    // Placement deadline
+    auto hboxDeadline = new QHBoxLayout();
+
+    m_placementDeadlineSpin = new QDoubleSpinBox(m_container);
+    m_placementDeadlineSpin->setRange(0.0, 3600.0);
+    m_placementDeadlineSpin->setSingleStep(0.1);
+    m_placementDeadlineSpin->setSuffix(" s");
+    m_placementDeadlineSpin->setSpecialValueText("Off");
+    m_placementDeadlineSpin->setValue(m_simulator->getPlacementDeadline());
+    hboxDeadline->addWidget(m_placementDeadlineSpin);
+
+    m_placementDeadlineApplyBtn = new QPushButton("Apply", m_container);
+    connect(m_placementDeadlineApplyBtn, &QPushButton::clicked, this, &ConfigurationDock::onPlacementDeadlineApplyClicked);
+    hboxDeadline->addWidget(m_placementDeadlineApplyBtn);
+
+    m_formLayout->addRow("Placement deadline:", hboxDeadline);
+
+    // Decision cache
+    m_placementCacheCheck = new QCheckBox("Reuse the decisions of identical bundles", m_container);
+    m_placementCacheCheck->setChecked(m_simulator->isPlacementCache());
+    connect(m_placementCacheCheck, &QCheckBox::toggled, this, &ConfigurationDock::onPlacementCacheToggled);
+    m_formLayout->addRow(m_placementCacheCheck);
+
+    // Periodic consolidation
+    auto hboxConsolidation = new QHBoxLayout();
+
+    m_consolidationIntervalSpin = new QDoubleSpinBox(m_container);
+    m_consolidationIntervalSpin->setRange(0.0, 604800.0);
+    m_consolidationIntervalSpin->setSingleStep(3600.0);
+    m_consolidationIntervalSpin->setSuffix(" s");
+    m_consolidationIntervalSpin->setSpecialValueText("Off");
+    m_consolidationIntervalSpin->setValue(m_simulator->getConsolidationInterval());
+    hboxConsolidation->addWidget(m_consolidationIntervalSpin);
+
+    m_consolidationBudgetSpin = new QDoubleSpinBox(m_container);
+    m_consolidationBudgetSpin->setRange(0.01, 3600.0);
+    m_consolidationBudgetSpin->setSingleStep(0.1);
+    m_consolidationBudgetSpin->setSuffix(" s");
+    m_consolidationBudgetSpin->setValue(m_simulator->getConsolidationBudget());
+    hboxConsolidation->addWidget(m_consolidationBudgetSpin);
+
+    m_consolidationApplyBtn = new QPushButton("Apply", m_container);
+    connect(m_consolidationApplyBtn, &QPushButton::clicked, this, &ConfigurationDock::onConsolidationApplyClicked);
+    hboxConsolidation->addWidget(m_consolidationApplyBtn);
+
+    m_formLayout->addRow("Consolidation (every / budget):", hboxConsolidation);
+
+    // Clustered placement
+    auto hboxClustering = new QHBoxLayout();
+
+    m_clusterSizeSpin = new QSpinBox(m_container);
+    m_clusterSizeSpin->setRange(0, 1000000);
+    m_clusterSizeSpin->setSingleStep(100);
+    m_clusterSizeSpin->setSuffix(" PMs");
+    m_clusterSizeSpin->setSpecialValueText("Off");
+    m_clusterSizeSpin->setValue(static_cast<int>(m_simulator->getPlacementClusterSize()));
+    hboxClustering->addWidget(m_clusterSizeSpin);
+
+    // Copies of the placement strategy keep its settings, a strategy picked by name runs with its
+    // defaults. The DQN agent observes the whole data center, it cannot run per cluster
+    m_clusterStrategyCombo = new QComboBox(m_container);
+    m_clusterStrategyCombo->addItem("Placement strategy", QString());
+    for (auto &info : StrategyFactory::availableStrategies())
+    {
+        if (info.name != "ILP + DQN Strategy")
+            m_clusterStrategyCombo->addItem(info.name, info.name);
+    }
+    m_clusterStrategyCombo->setCurrentIndex(m_clusterStrategyCombo->findData(QString::fromStdString(m_simulator->getPlacementClusterStrategy())));
+    hboxClustering->addWidget(m_clusterStrategyCombo);
+
+    m_clusteringApplyBtn = new QPushButton("Apply", m_container);
+    connect(m_clusteringApplyBtn, &QPushButton::clicked, this, &ConfigurationDock::onClusteringApplyClicked);
+    hboxClustering->addWidget(m_clusteringApplyBtn);
+
+    m_formLayout->addRow("Clusters (size / strategy):", hboxClustering);
+
     // Strategy
     m_strategyCombo = new QComboBox(m_container);
     loadStrategyList();
@@ -175,6 +331,90 @@ void ConfigurationDock::onStrategyApplyClicked()
     m_strategyCombo->setCurrentIndex(-1);
 }
 
+void ConfigurationDock::onMigrationPolicyChanged(int index)
+{
+    if (index < 0 || !m_simulator)
+        return;
+
+    auto policy = static_cast<MigrationSelectionPolicy>(m_migrationPolicyCombo->itemData(index).toInt());
+    m_simulator->setMigrationSelectionPolicy(policy);
+    qDebug() << "[ConfigurationDock] Migration selection policy set to" << m_migrationPolicyCombo->itemText(index);
+}
+
+void ConfigurationDock::onBundleSchedulingApplyClicked()
+{
+    if (!m_simulator)
+        return;
+
+    m_simulator->setMaxBundleWait(m_maxBundleWaitSpin->value());
+    m_simulator->setBundleSizingMode(m_adaptiveBundleCheck->isChecked() ? BundleSizingMode::Adaptive : BundleSizingMode::Strategy);
+    m_simulator->setAdaptiveBundleLimits(m_minBundleSizeSpin->value(), m_maxBundleSizeSpin->value());
+    m_simulator->setTargetSolveTime(m_targetSolveTimeSpin->value());
+    qDebug() << "[ConfigurationDock] Max bundle wait set to" << m_maxBundleWaitSpin->value()
+             << "adaptive:" << m_adaptiveBundleCheck->isChecked()
+             << "limits:" << m_minBundleSizeSpin->value() << m_maxBundleSizeSpin->value()
+             << "target solve time:" << m_targetSolveTimeSpin->value();
+}
+
+void ConfigurationDock::onEventBatchingToggled(bool checked)
+{
+    if (!m_simulator)
+        return;
+
+    m_simulator->setEventBatching(checked);
+    qDebug() << "[ConfigurationDock] Event batching" << (checked ? "enabled" : "disabled");
+}
+
+void ConfigurationDock::onAsyncPlacementApplyClicked()
+{
+    if (!m_simulator)
+        return;
+
+    m_simulator->setAsyncPlacement(m_asyncPlacementCheck->isChecked());
+    m_simulator->setDecisionLatency(m_decisionLatencySpin->value());
+    qDebug() << "[ConfigurationDock] Async placement" << (m_asyncPlacementCheck->isChecked() ? "enabled" : "disabled")
+             << "decision latency:" << m_decisionLatencySpin->value();
+}
+
+void ConfigurationDock::onPlacementDeadlineApplyClicked()
+{
+    if (!m_simulator)
+        return;
+
+    m_simulator->setPlacementDeadline(m_placementDeadlineSpin->value());
+    qDebug() << "[ConfigurationDock] Placement deadline set to" << m_placementDeadlineSpin->value();
+}
+
+void ConfigurationDock::onPlacementCacheToggled(bool checked)
+{
+    if (!m_simulator)
+        return;
+
+    m_simulator->setPlacementCache(checked);
+    qDebug() << "[ConfigurationDock] Placement cache" << (checked ? "enabled" : "disabled");
+}
+
+void ConfigurationDock::onConsolidationApplyClicked()
+{
+    if (!m_simulator)
+        return;
+
+    m_simulator->setConsolidationInterval(m_consolidationIntervalSpin->value());
+    m_simulator->setConsolidationBudget(m_consolidationBudgetSpin->value());
+    qDebug() << "[ConfigurationDock] Consolidation interval set to" << m_consolidationIntervalSpin->value()
+             << "budget:" << m_consolidationBudgetSpin->value();
+}
+
+void ConfigurationDock::onClusteringApplyClicked()
+{
+    if (!m_simulator || m_clusterStrategyCombo->currentIndex() < 0)
+        return;
+
+    m_simulator->setPlacementClustering(m_clusterSizeSpin->value(), m_clusterStrategyCombo->currentData().toString().toStdString());
+    qDebug() << "[ConfigurationDock] Clustered placement on clusters of" << m_clusterSizeSpin->value()
+             << "PMs with" << m_clusterStrategyCombo->currentText();
+}
+
 void ConfigurationDock::onOutputFileBrowseClicked()
 {
     QString path = QFileDialog::getSaveFileName(this, "Select Output File");
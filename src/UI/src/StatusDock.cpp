@@ -28,6 +28,11 @@ void StatusDock::createUI()
     m_turnedOnMachineCountLabel = new QLabel("0", container);
     m_currentStrategyLabel = new QLabel("None", container);
     m_currentBundleSizeLabel = new QLabel("0", container);
+    m_placementDelayLabel = new QLabel("0", container);
+    m_arrivalRateLabel = new QLabel("0", container);
+    m_placementCacheLabel = new QLabel("0", container);
+    m_consolidationLabel = new QLabel("0", container);
+    m_clusteringLabel = new QLabel("0", container);
 
     m_formLayout->addRow("Time:", m_timeLabel);
     m_formLayout->addRow("Event count:", m_eventCountLabel);
@@ -37,6 +42,11 @@ void StatusDock::createUI()
     m_formLayout->addRow("Turned on machine count:", m_turnedOnMachineCountLabel);
     m_formLayout->addRow("Current strategy:", m_currentStrategyLabel);
     m_formLayout->addRow("Current bundle size:", m_currentBundleSizeLabel);
+    m_formLayout->addRow("Placement delay (avg / max):", m_placementDelayLabel);
+    m_formLayout->addRow("Arrival rate / last solve:", m_arrivalRateLabel);
+    m_formLayout->addRow("Placement cache hits:", m_placementCacheLabel);
+    m_formLayout->addRow("Consolidation migrations:", m_consolidationLabel);
+    m_formLayout->addRow("Clustered placements:", m_clusteringLabel);
 
     container->setLayout(m_formLayout);
     setWidget(container);
@@ -57,6 +67,14 @@ void StatusDock::updateStatus()
     m_turnedOnMachineCountLabel->setText(QString::number(m_status->getTurnedOnMachineCount()));
     m_currentStrategyLabel->setText(QString::fromStdString(m_status->getCurrentStrategy()));
     m_currentBundleSizeLabel->setText(QString::number(m_status->getCurrentBundleSize()));
+    m_placementDelayLabel->setText(QString::number(m_status->getAveragePlacementDelay()) + " / " + QString::number(m_status->getMaxPlacementDelay()) + " s");
+    m_arrivalRateLabel->setText(QString::number(m_status->getArrivalRate()) + " /s / " + QString::number(m_status->getLastSolveTime()) + " s");
+
+    size_t lookups = m_status->getPlacementCacheLookups();
+    double hitRate = lookups > 0 ? 100.0 * m_status->getPlacementCacheHits() / lookups : 0.0;
+    m_placementCacheLabel->setText(QString::number(m_status->getPlacementCacheHits()) + " / " + QString::number(lookups) + " (" + QString::number(hitRate, 'f', 1) + "%)");
+    m_consolidationLabel->setText(QString::number(m_status->getConsolidationMigrationCount()));
+    m_clusteringLabel->setText(QString::number(m_status->getClusteredPlacementCount()) + " (last on " + QString::number(m_status->getActiveClusterCount()) + " / " + QString::number(m_status->getClusterCount()) + " clusters)");
 }
 
 void StatusDock::onTimer()